@@ -0,0 +1,41 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// best mean time per iteration over a few rounds, in nanoseconds
+// the best round rather than the average keeps scheduler noise out of small differences
+template <typename F>
+double measure(size_t iterations, F&& body, int rounds = 5) {
+    // warm up caches and lazily resolved entry points
+    for (size_t i = 0; i < iterations / 8 + 1; i++) {
+        body(i);
+    }
+    double best = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            body(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / double(iterations);
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+inline void report(const char *name, double ns) {
+    if (ns >= 1e6) {
+        std::printf("%-48s %12.3f ms\n", name, ns / 1e6);
+    } else if (ns >= 1e3) {
+        std::printf("%-48s %12.3f us\n", name, ns / 1e3);
+    } else {
+        std::printf("%-48s %12.3f ns\n", name, ns);
+    }
+}
+
+#endif
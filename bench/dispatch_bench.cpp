@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include "headless_context.hpp"
+
+// cost of a gl:: wrapper over calling glad directly
+// the first set goes to the driver, the second points glad and a hand filled table at an empty function
+// so only the call overhead is left, with OPENGL_HPP_HEADER_ONLY the wrapper should match raw glad there
+
+static void APIENTRY emptyViewport(GLint, GLint, GLsizei, GLsizei) {}
+
+#ifdef OPENGL_HPP_INLINE
+static const char *mode = "header only";
+#else
+static const char *mode = "compiled";
+#endif
+
+int main() {
+    gl::HeadlessContext context;
+    const gl::Dispatch& d = context.getDispatch();
+    gl::defaultDispatch.loadFromGlad();
+    gl::Dispatch lazy;
+    lazy.loadLazy(gl::HeadlessContext::getProcAddress);
+
+    constexpr size_t iterations = 1 << 22;
+    std::printf("%s wrappers, %zu calls of glViewport\n", mode, iterations);
+    report("raw glad", measure(iterations, [](size_t i) { glad_glViewport(0, 0, GLsizei(i & 255) + 1, 1); }));
+    report("dispatch table", measure(iterations, [&](size_t i) { d.glViewport(0, 0, GLsizei(i & 255) + 1, 1); }));
+    report("lazily loaded dispatch table", measure(iterations, [&](size_t i) { lazy.glViewport(0, 0, GLsizei(i & 255) + 1, 1); }));
+    report("gl::viewport with a dispatch", measure(iterations, [&](size_t i) { gl::viewport(0, 0, uint32_t(i & 255) + 1, 1, d); }));
+    report("gl::viewport with the default dispatch", measure(iterations, [](size_t i) { gl::viewport(0, 0, uint32_t(i & 255) + 1, 1); }));
+
+    // volatile so the compiler cannot see through the pointers and drop the calls
+    PFNGLVIEWPORTPROC volatile empty = emptyViewport;
+    glad_glViewport = empty;
+    gl::Dispatch mock;
+    mock.glViewport = empty;
+    std::printf("\n%zu calls of an empty glViewport\n", iterations);
+    report("raw glad", measure(iterations, [](size_t i) { glad_glViewport(0, 0, GLsizei(i & 255) + 1, 1); }));
+    report("dispatch table", measure(iterations, [&](size_t i) { mock.glViewport(0, 0, GLsizei(i & 255) + 1, 1); }));
+    report("gl::viewport with a dispatch", measure(iterations, [&](size_t i) { gl::viewport(0, 0, uint32_t(i & 255) + 1, 1, mock); }));
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "bench.hpp"
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// cpu only, the optimisers on a shuffled grid with the acmr each one reaches
+
+static constexpr uint32_t size = 256;
+
+int main() {
+    uint32_t row = size + 1;
+    size_t vertexCount = size_t(row) * row;
+    std::vector<float> positions;
+    for (uint32_t y = 0; y < row; y++) {
+        for (uint32_t x = 0; x < row; x++) {
+            positions.insert(positions.end(), {float(x), float(y), float((x * 7 + y * 13) % 5)});
+        }
+    }
+    std::vector<uint32_t> quads(size_t(size) * size);
+    for (size_t i = 0; i < quads.size(); i++) {
+        quads[i] = uint32_t(i);
+    }
+    std::shuffle(quads.begin(), quads.end(), std::mt19937(7));
+    std::vector<uint32_t> indices;
+    for (uint32_t quad : quads) {
+        uint32_t v = quad / size * row + quad % size;
+        indices.insert(indices.end(), {v, v + 1, v + row, v + 1, v + row + 1, v + row});
+    }
+    std::vector<uint32_t> dst(indices.size());
+    std::vector<uint32_t> overdraw(indices.size());
+
+    std::printf("%zu triangles, %zu vertices, shuffled acmr %.3f\n", indices.size() / 3, vertexCount,
+                gl::analyzeVertexCache(indices.data(), indices.size(), vertexCount).acmr);
+    report("analyzeVertexCache", measure(4, [&](size_t) {
+        gl::analyzeVertexCache(indices.data(), indices.size(), vertexCount);
+    }));
+    report("optimizeVertexCache (forsyth)", measure(4, [&](size_t) {
+        gl::optimizeVertexCache(dst.data(), indices.data(), indices.size(), vertexCount);
+    }));
+    std::printf("  acmr %.3f\n", gl::analyzeVertexCache(dst.data(), dst.size(), vertexCount).acmr);
+    report("optimizeOverdraw", measure(4, [&](size_t) {
+        gl::optimizeOverdraw(overdraw.data(), dst.data(), dst.size(), positions.data(), vertexCount, sizeof(float) * 3);
+    }));
+    std::printf("  acmr %.3f\n", gl::analyzeVertexCache(overdraw.data(), overdraw.size(), vertexCount).acmr);
+    report("optimizeVertexCacheTipsify", measure(4, [&](size_t) {
+        gl::optimizeVertexCacheTipsify(dst.data(), indices.data(), indices.size(), vertexCount);
+    }));
+    std::printf("  acmr %.3f\n", gl::analyzeVertexCache(dst.data(), dst.size(), vertexCount).acmr);
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<uint32_t> remapped(dst.size());
+    std::vector<float> fetched(positions.size());
+    report("optimizeVertexFetchRemap and remapVertices", measure(4, [&](size_t) {
+        remapped = dst;
+        size_t used = gl::optimizeVertexFetchRemap(remap.data(), remapped.data(), remapped.size(), vertexCount);
+        gl::remapVertices(fetched.data(), positions.data(), vertexCount, sizeof(float) * 3, remap.data());
+        (void)used;
+    }));
+    return 0;
+}
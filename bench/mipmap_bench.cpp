@@ -0,0 +1,86 @@
+#include "bench.hpp"
+#include "headless_context.hpp"
+#include "mipmap_generator.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// full mip chains for a batch of rgb8 images, built on cpu threads by MipmapGenerator
+// versus uploaded as level 0 and built with glGenerateTextureMipmap, both timed until the gpu is done
+
+static constexpr uint32_t size = 1024;
+static constexpr size_t imageCount = 16;
+
+static std::vector<uint8_t> makeImage(uint32_t seed) {
+    std::vector<uint8_t> pixels(size_t(size) * size * 3);
+    uint32_t state = seed * 747796405u + 1;
+    for (auto& pixel : pixels) {
+        state = state * 1664525u + 1013904223u;
+        pixel = uint8_t(state >> 24);
+    }
+    return pixels;
+}
+
+int main() {
+    gl::HeadlessContext context;
+    const gl::Dispatch& d = context.getDispatch();
+    std::vector<std::vector<uint8_t>> images;
+    for (size_t i = 0; i < imageCount; i++) {
+        images.push_back(makeImage(uint32_t(i)));
+    }
+    uint32_t levels = gl::getMipLevelCount(size, size);
+    std::vector<uint8_t> rgba(size_t(size) * size * 4);
+    std::vector<uint8_t> chain(gl::getMipChainSize(size, size, levels));
+
+    std::printf("%zu images of %ux%u rgb8, time per image\n", imageCount, size, size);
+    report("convertToRGBA8", measure(imageCount, [&](size_t i) {
+        gl::convertToRGBA8(gl::Format::eRGB, images[i].data(), rgba.data(), size_t(size) * size);
+    }, 3));
+    for (gl::MipFilter filter : {gl::MipFilter::eBox, gl::MipFilter::eKaiser}) {
+        for (bool srgb : {false, true}) {
+            std::string name = std::string("generateMipChain, one thread, ") + (filter == gl::MipFilter::eBox ? "box" : "kaiser") + (srgb ? ", srgb" : "");
+            report(name.c_str(), measure(imageCount, [&](size_t) {
+                gl::generateMipChain(rgba.data(), size, size, levels, chain.data(), filter, srgb);
+            }, 3));
+        }
+    }
+
+    // whole batches, so the worker threads overlap
+    gl::MipmapGenerator::CreateInfo info;
+    info.stagingSize = chain.size() * imageCount;
+    gl::MipmapGenerator generator(info, d);
+    auto waitGPU = [&]() {
+        GLsync fence = d.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        d.glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        d.glDeleteSync(fence);
+    };
+    std::vector<gl::Texture> textures;
+    auto deleteTextures = [&]() {
+        gl::Texture::deleteTextures(textures.size(), textures.data(), d);
+        textures.clear();
+    };
+    double cpu = measure(1, [&](size_t) {
+        for (auto& image : images) {
+            textures.push_back(generator.add(size, size, gl::Format::eRGB, image.data()));
+        }
+        generator.upload();
+        waitGPU();
+        deleteTextures();
+    }, 3);
+    report("MipmapGenerator, add and upload", cpu / imageCount);
+
+    double gpu = measure(1, [&](size_t) {
+        for (auto& image : images) {
+            gl::Texture texture = gl::Texture::createTexture(gl::TextureType::e2D, d);
+            texture.storage2D(levels, gl::InternalFormat::eR8G8B8A8, size, size, d);
+            texture.subImage2D(0, 0, 0, size, size, gl::Format::eRGB, gl::Type::eUnsignedByte, image.data(), d);
+            texture.generateMipmap(d);
+            textures.push_back(texture);
+        }
+        waitGPU();
+        deleteTextures();
+    }, 3);
+    report("subImage2D and glGenerateTextureMipmap", gpu / imageCount);
+    return 0;
+}
@@ -82,12 +82,13 @@ int main() {
 
     glfwMakeContextCurrent(window);                     
 
-    gladLoadGL();
+    // resolves only the entry points the gl:: layer uses, each on its first call
+    gl::defaultDispatch.loadLazy((GLADloadproc)glfwGetProcAddress);
 
     gl::Shader vertShader = gl::Shader::createShader(gl::ShaderType::eVertex);
-    vertShader.source(1, readFile("../../shaders/test.vert").c_str(), NULL);
+    vertShader.source(1, readFile(SHADER_DIR "test.vert").c_str(), NULL);
     gl::Shader fragShader = gl::Shader::createShader(gl::ShaderType::eFragment);
-    fragShader.source(1, readFile("../../shaders/test.frag").c_str(), NULL);
+    fragShader.source(1, readFile(SHADER_DIR "test.frag").c_str(), NULL);
     
     std::cout << vertShader.getInfoLog() << '\n';
     std::cout << fragShader.getInfoLog() << '\n';
@@ -0,0 +1,45 @@
+#ifndef BARRIER_TRACKER_HPP
+#define BARRIER_TRACKER_HPP
+
+#include "opengl.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace gl {
+
+// remembers which resources were written by shaders (compute, image stores, ssbo writes, atomics)
+// and issues only the barrier bits the next consumer of those resources actually needs
+class BarrierTracker {
+public:
+    void write(Buffer& buffer);
+    // image stores, same as writeImage
+    void write(Texture& texture);
+    void writeImage(GLuint texture);
+    // access describes how the resource is consumed next, eg MemoryBarrierBits::eCommand for indirect args
+    void read(Buffer& buffer, MemoryBarrierBits access);
+    void read(Texture& texture, MemoryBarrierBits access);
+    void readImage(GLuint texture, MemoryBarrierBits access);
+    // issues a single glMemoryBarrier for everything requested by read() since the last flush
+    void flush(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // forget all pending writes, eg after an external glFinish
+    void reset();
+    // drops the entry of a resource, call it before deleting one that was written so the map does not keep it
+    // an entry otherwise lives until every barrier bit has been issued since its last write
+    void forget(Buffer& buffer);
+    void forget(Texture& texture);
+    void forgetImage(GLuint texture);
+
+private:
+    void writeKey(uint64_t key);
+    void readKey(uint64_t key, GLbitfield access);
+
+private:
+    // barrier bits already issued since each resource was last written
+    std::unordered_map<uint64_t, GLbitfield> m_written;
+    GLbitfield m_pending = 0;
+};
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef CLUSTER_CULLER_HPP
+#define CLUSTER_CULLER_HPP
+
+#include "depth_pyramid.hpp"
+#include "index_buffer.hpp"
+#include "meshlet_builder.hpp"
+#include "opengl.hpp"
+
+#include <cstdint>
+
+namespace gl {
+
+// culls the meshlets of one mesh on the gpu and draws the survivors with a single indirect count draw, so the
+// triangles submitted follow what is visible rather than what is loaded
+// every meshlet is tested against the frustum, its normal cone and optionally a DepthPyramid, the visible ones are
+// appended as DrawElementsIndirectCommands over their range of the index buffer, with baseInstance set to the meshlet
+//
+// per frame:
+//   cull(view), optionally after building a pyramid from last frame's or a depth prepass's depth
+//   bind a vertex array with getIndexBuffer() attached and a program, then draw()
+// matrices are column major and clip space is the default one, z in [-w, w] mapping to depth [0, 1]
+class ClusterCuller {
+public:
+    struct CreateInfo {
+        // only read by the constructor
+        const MeshletMesh *mesh;
+        // vertices the mesh's indices refer to, picks the index type
+        size_t vertexCount;
+        // the meshlets, commands and count go to shader storage bindings firstBinding to firstBinding + 2
+        uint32_t firstBinding = 0;
+        uint32_t uniformBinding = 0;
+        // unit the pyramid is sampled from when occlusion culling
+        uint32_t textureUnit = 0;
+    };
+
+    struct View {
+        float viewProjection[16];
+        float model[16];
+        // world space
+        float cameraPosition[3];
+        // nullptr skips occlusion culling, otherwise it must hold depth rendered with viewProjection or close to it
+        DepthPyramid *pyramid = nullptr;
+    };
+
+    explicit ClusterCuller(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~ClusterCuller();
+    ClusterCuller(const ClusterCuller&) = delete;
+    ClusterCuller& operator=(const ClusterCuller&) = delete;
+
+    // rewrites the commands and count, leaves the program unbound and ends with command and storage barriers
+    void cull(const View& view);
+    // binds the command and count buffers and issues every surviving draw, the vertex array must be bound
+    void draw(Primitive mode = Primitive::eTriangles);
+
+    const IndexBuffer& getIndexBuffer() const;
+    // DrawElementsIndirectCommands, one slot per meshlet
+    Buffer getCommandBuffer() const;
+    // a single uint holding the number of commands written
+    Buffer getCountBuffer() const;
+    size_t getMeshletCount() const;
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    size_t m_meshletCount;
+    IndexBuffer m_indexBuffer;
+    Buffer m_meshlets;
+    Buffer m_commands;
+    Buffer m_count;
+    Buffer m_uniforms;
+    Program m_program;
+};
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef DEPTH_PYRAMID_HPP
+#define DEPTH_PYRAMID_HPP
+
+#include "opengl.hpp"
+
+#include <cstdint>
+
+namespace gl {
+
+// hierarchical z for occlusion culling, an r32f texture with a full mip chain where every texel holds the farthest
+// depth of the level 0 texels it covers, odd sizes fold the leftover row and column into the edge texels
+// so texel floor(p / 2^level) of any level bounds pixel p, depth is the standard [0, 1] with 0 near
+class DepthPyramid {
+public:
+    struct CreateInfo {
+        // size of the depth textures passed to build
+        uint32_t width;
+        uint32_t height;
+        // build() binds the depth texture to textureUnit and two pyramid levels to imageUnit and imageUnit + 1
+        uint32_t textureUnit = 0;
+        uint32_t imageUnit = 0;
+    };
+
+    explicit DepthPyramid(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~DepthPyramid();
+    DepthPyramid(const DepthPyramid&) = delete;
+    DepthPyramid& operator=(const DepthPyramid&) = delete;
+
+    // reduces depth, a width x height depth texture, into every level with one dispatch per level
+    // leaves the program unbound and ends with a texture fetch barrier so the next dispatch can sample the result
+    void build(Texture& depth);
+    // sampling must use texelFetch, the texture is not filterable across levels in a meaningful way
+    void bindUnit(uint32_t unit);
+
+    Texture getTexture() const;
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    uint32_t getLevelCount() const;
+
+    // glsl defining `bool depthPyramidOccluded(sampler2D pyramid, vec3 size, mat4 viewProjection, vec3 center, float radius)`
+    // size is the width, height and level count, true when the sphere lies entirely behind the depth in pyramid
+    // spheres reaching behind the camera are never occluded
+    static const char *getOcclusionGLSL();
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    uint32_t m_levels;
+    Texture m_texture;
+    Program m_copy;
+    Program m_reduce;
+};
+
+// the six planes of a column major viewProjection as normalised xyz, w with the normals pointing inwards,
+// a sphere is outside when dot(xyz, center) + w < -radius for any of them
+void extractFrustumPlanes(const float *viewProjection, float planes[6][4]);
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,303 @@
+#ifndef DISPATCH_HPP
+#define DISPATCH_HPP
+
+#include "glext.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// number of Dispatch tables that can be loaded lazily at the same time, each one gets its own set of trampolines
+#ifndef OPENGL_HPP_LAZY_TABLES
+#define OPENGL_HPP_LAZY_TABLES 4
+#endif
+
+namespace gl {
+
+struct Dispatch;
+
+namespace detail {
+
+// one lazily loaded table and the loader its trampolines resolve through, see Dispatch::loadLazy
+struct LazySlot {
+    std::mutex mutex;
+    Dispatch *table = nullptr;
+    GLADloadproc getProcAddress = nullptr;
+};
+
+struct LazyState {
+    std::mutex mutex;
+    LazySlot slots[OPENGL_HPP_LAZY_TABLES];
+};
+
+inline LazyState& lazyState() {
+    static LazyState state;
+    return state;
+}
+
+template <auto Member, typename Tag, typename Fn, size_t Slot>
+struct LazyEntry;
+
+// first call resolves the real entry point through its own table's loader, patches it into that table and forwards
+template <auto Member, typename Tag, typename R, typename... Args, size_t Slot>
+struct LazyEntry<Member, Tag, R (APIENTRYP)(Args...), Slot> {
+    using Fn = R (APIENTRYP)(Args...);
+
+    static R APIENTRY trampoline(Args... args) {
+        Fn fn;
+        {
+            LazySlot& slot = lazyState().slots[Slot];
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            fn = reinterpret_cast<Fn>(slot.getProcAddress(Tag::name()));
+            if (!fn) {
+                throw std::runtime_error(std::string("Failed to resolve ") + Tag::name() + "!");
+            }
+            slot.table->*Member = fn;
+        }
+        return fn(args...);
+    }
+};
+
+} // namespace detail
+
+// every entry point the gl:: layer calls, hot per draw/dispatch calls first so they share cache lines
+#define OPENGL_HPP_DISPATCH_HOT(X) \
+    X(glDrawArrays) \
+    X(glDrawElements) \
+    X(glDrawArraysInstancedBaseInstance) \
+    X(glDrawElementsInstancedBaseVertexBaseInstance) \
+    X(glMultiDrawElementsIndirect) \
+    X(glMultiDrawElementsIndirectCount) \
+    X(glDispatchCompute) \
+    X(glDispatchComputeIndirect) \
+    X(glBindVertexArray) \
+    X(glBindTextureUnit) \
+    X(glBindImageTexture) \
+    X(glUseProgram) \
+    X(glBindProgramPipeline) \
+    X(glBindFramebuffer) \
+    X(glViewport) \
+    X(glBindBuffer) \
+    X(glBindBufferBase) \
+    X(glBindBufferRange) \
+    X(glBindBuffersBase) \
+    X(glBindBuffersRange) \
+    X(glMemoryBarrier) \
+    X(glMemoryBarrierByRegion) \
+    X(glNamedBufferSubData) \
+    X(glMapNamedBufferRange) \
+    X(glFlushMappedNamedBufferRange) \
+    X(glUnmapNamedBuffer) \
+    X(glInvalidateBufferData) \
+    X(glInvalidateBufferSubData) \
+    X(glClear) \
+    X(glClearColor) \
+    X(glEnable) \
+    X(glDisable) \
+    X(glFenceSync) \
+    X(glClientWaitSync) \
+    X(glWaitSync) \
+    X(glDeleteSync) \
+    X(glFlush) \
+    X(glReadPixels)
+
+#define OPENGL_HPP_DISPATCH_COLD(X) \
+    X(glCreateBuffers) \
+    X(glDeleteBuffers) \
+    X(glNamedBufferStorage) \
+    X(glNamedBufferData) \
+    X(glGetNamedBufferSubData) \
+    X(glCopyNamedBufferSubData) \
+    X(glCreateVertexArrays) \
+    X(glDeleteVertexArrays) \
+    X(glEnableVertexArrayAttrib) \
+    X(glDisableVertexArrayAttrib) \
+    X(glVertexArrayAttribBinding) \
+    X(glVertexArrayAttribFormat) \
+    X(glVertexArrayAttribIFormat) \
+    X(glVertexArrayAttribLFormat) \
+    X(glVertexArrayVertexBuffer) \
+    X(glVertexArrayBindingDivisor) \
+    X(glVertexArrayElementBuffer) \
+    X(glCreateShader) \
+    X(glDeleteShader) \
+    X(glShaderSource) \
+    X(glCompileShader) \
+    X(glShaderBinary) \
+    X(glSpecializeShader) \
+    X(glGetShaderiv) \
+    X(glGetShaderInfoLog) \
+    X(glCreateProgram) \
+    X(glCreateShaderProgramv) \
+    X(glDeleteProgram) \
+    X(glAttachShader) \
+    X(glProgramParameteri) \
+    X(glLinkProgram) \
+    X(glGetProgramiv) \
+    X(glGetProgramInfoLog) \
+    X(glCreateProgramPipelines) \
+    X(glDeleteProgramPipelines) \
+    X(glUseProgramStages) \
+    X(glActiveShaderProgram) \
+    X(glValidateProgramPipeline) \
+    X(glGetProgramPipelineiv) \
+    X(glGetProgramPipelineInfoLog) \
+    X(glCreateRenderbuffers) \
+    X(glDeleteRenderbuffers) \
+    X(glNamedRenderbufferStorage) \
+    X(glNamedRenderbufferStorageMultisample) \
+    X(glCreateFramebuffers) \
+    X(glDeleteFramebuffers) \
+    X(glNamedFramebufferRenderbuffer) \
+    X(glNamedFramebufferDrawBuffers) \
+    X(glNamedFramebufferReadBuffer) \
+    X(glCheckNamedFramebufferStatus) \
+    X(glBlitNamedFramebuffer) \
+    X(glGetIntegerv) \
+    X(glGetStringi) \
+    X(glCreateTextures) \
+    X(glDeleteTextures) \
+    X(glBindTexture) \
+    X(glTextureStorage1D) \
+    X(glTextureStorage2D) \
+    X(glTextureStorage3D) \
+    X(glTextureSubImage2D) \
+    X(glTextureSubImage3D) \
+    X(glCompressedTextureSubImage2D) \
+    X(glCompressedTextureSubImage3D) \
+    X(glTextureParameteri) \
+    X(glGenerateTextureMipmap) \
+    X(glClearTexImage) \
+    X(glGetInternalformativ) \
+    X(glNamedFramebufferTexture) \
+    X(glClearNamedFramebufferuiv) \
+    X(glClearNamedFramebufferfv)
+
+// entry points from glext.hpp, glad knows nothing about these so they are listed with their type
+// loadFromGlad leaves them null, use load or loadLazy to reach them
+#define OPENGL_HPP_DISPATCH_EXT(X) \
+    X(glNamedBufferPageCommitmentARB, PFNGLNAMEDBUFFERPAGECOMMITMENTARBPROC) \
+    X(glTexPageCommitmentARB, PFNGLTEXPAGECOMMITMENTARBPROC)
+
+#define OPENGL_HPP_DISPATCH_ENTRIES(X) \
+    OPENGL_HPP_DISPATCH_HOT(X) \
+    OPENGL_HPP_DISPATCH_COLD(X)
+
+// table of gl entry points used by the wrappers, similar to vulkan.hpp's DispatchLoaderDynamic
+// load one per context (or per loader), or fill it by hand to route calls into a mock or profiler
+// note: glad #defines glFoo as glad_glFoo, so members are spelled dispatch.glFoo but named glad_glFoo
+struct Dispatch {
+#define OPENGL_HPP_DISPATCH_MEMBER(name) decltype(::name) name = nullptr;
+    OPENGL_HPP_DISPATCH_ENTRIES(OPENGL_HPP_DISPATCH_MEMBER)
+#undef OPENGL_HPP_DISPATCH_MEMBER
+#define OPENGL_HPP_DISPATCH_EXT_MEMBER(name, type) type name = nullptr;
+    OPENGL_HPP_DISPATCH_EXT(OPENGL_HPP_DISPATCH_EXT_MEMBER)
+#undef OPENGL_HPP_DISPATCH_EXT_MEMBER
+
+    // resolves every entry through getProcAddress, eg glfwGetProcAddress
+    void load(GLADloadproc getProcAddress) {
+#define OPENGL_HPP_DISPATCH_LOAD(name) this->name = reinterpret_cast<decltype(::name)>(getProcAddress(#name));
+        OPENGL_HPP_DISPATCH_ENTRIES(OPENGL_HPP_DISPATCH_LOAD)
+#undef OPENGL_HPP_DISPATCH_LOAD
+#define OPENGL_HPP_DISPATCH_EXT_LOAD(name, type) this->name = reinterpret_cast<type>(getProcAddress(#name));
+        OPENGL_HPP_DISPATCH_EXT(OPENGL_HPP_DISPATCH_EXT_LOAD)
+#undef OPENGL_HPP_DISPATCH_EXT_LOAD
+    }
+
+    // copies the pointers glad resolved in gladLoadGL/gladLoadGLLoader
+    void loadFromGlad() {
+#define OPENGL_HPP_DISPATCH_COPY(name) this->name = ::name;
+        OPENGL_HPP_DISPATCH_ENTRIES(OPENGL_HPP_DISPATCH_COPY)
+#undef OPENGL_HPP_DISPATCH_COPY
+    }
+
+    // points every entry at a trampoline that resolves it through getProcAddress on first call, so startup resolves nothing
+    // after the first call an entry costs the same as an eagerly loaded one
+    // each table keeps its own getProcAddress, so tables for different contexts can be loaded lazily side by side,
+    // at most OPENGL_HPP_LAZY_TABLES at once, throws when they are all taken
+    // a trampoline throws when getProcAddress returns null for its entry
+    // resolving writes the entry with a plain store, so a lazy table must only be called from one thread at a time,
+    // like the context it belongs to, call each entry once before sharing the table across threads
+    void loadLazy(GLADloadproc getProcAddress) {
+        detail::LazyState& state = detail::lazyState();
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (m_lazySlot == noLazySlot) {
+                for (size_t slot = 0; slot < OPENGL_HPP_LAZY_TABLES && m_lazySlot == noLazySlot; slot++) {
+                    if (!state.slots[slot].table) {
+                        m_lazySlot = slot;
+                    }
+                }
+                if (m_lazySlot == noLazySlot) {
+                    throw std::runtime_error("Failed to load lazily, OPENGL_HPP_LAZY_TABLES tables are already lazily loaded!");
+                }
+            }
+            detail::LazySlot& slot = state.slots[m_lazySlot];
+            std::lock_guard<std::mutex> slotLock(slot.mutex);
+            slot.table = this;
+            slot.getProcAddress = getProcAddress;
+        }
+        setTrampolines(m_lazySlot, std::make_index_sequence<OPENGL_HPP_LAZY_TABLES>());
+    }
+
+    Dispatch() = default;
+    Dispatch(const Dispatch&) = delete;
+    Dispatch& operator=(const Dispatch&) = delete;
+    ~Dispatch() {
+        if (m_lazySlot != noLazySlot) {
+            detail::LazyState& state = detail::lazyState();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            detail::LazySlot& slot = state.slots[m_lazySlot];
+            std::lock_guard<std::mutex> slotLock(slot.mutex);
+            slot.table = nullptr;
+            slot.getProcAddress = nullptr;
+        }
+    }
+
+private:
+    static constexpr size_t noLazySlot = ~size_t(0);
+
+    // the trampolines of a slot only ever patch the table holding it
+    template <size_t Slot>
+    void setTrampolines() {
+#define OPENGL_HPP_DISPATCH_EXT_LAZY(entry, type) \
+        { \
+            struct Tag { \
+                static const char *name() { return #entry; } \
+            }; \
+            this->entry = &detail::LazyEntry<&Dispatch::entry, Tag, type, Slot>::trampoline; \
+        }
+#define OPENGL_HPP_DISPATCH_LAZY(entry) \
+        { \
+            struct Tag { \
+                static const char *name() { return #entry; } \
+            }; \
+            this->entry = &detail::LazyEntry<&Dispatch::entry, Tag, decltype(::entry), Slot>::trampoline; \
+        }
+        OPENGL_HPP_DISPATCH_ENTRIES(OPENGL_HPP_DISPATCH_LAZY)
+        OPENGL_HPP_DISPATCH_EXT(OPENGL_HPP_DISPATCH_EXT_LAZY)
+#undef OPENGL_HPP_DISPATCH_LAZY
+#undef OPENGL_HPP_DISPATCH_EXT_LAZY
+    }
+
+    template <size_t... Slots>
+    void setTrampolines(size_t slot, std::index_sequence<Slots...>) {
+        ((slot == Slots ? setTrampolines<Slots>() : void()), ...);
+    }
+
+private:
+    size_t m_lazySlot = noLazySlot;
+};
+
+// used by every wrapper that is not handed a Dispatch explicitly
+inline Dispatch defaultDispatch;
+
+} // namespace gl
+
+#ifndef OPENGL_HPP_DEFAULT_DISPATCHER
+#define OPENGL_HPP_DEFAULT_DISPATCHER ::gl::defaultDispatch
+#endif
+
+#endif
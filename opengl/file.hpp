@@ -0,0 +1,28 @@
+#ifndef FILE_HPP
+#define FILE_HPP
+
+#include <cstddef>
+
+namespace gl {
+
+// read only view of a whole file, backed by mmap where available
+class MappedFile {
+public:
+    MappedFile() = delete;
+    static MappedFile mapFile(const char *filePath);
+    static void unmapFile(MappedFile& mappedFile);
+
+    const void *data() const;
+    size_t size() const;
+
+private:
+    MappedFile(void *data, size_t size);
+
+private:
+    void *m_data;
+    size_t m_size;
+};
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef HEADLESS_CONTEXT_HPP
+#define HEADLESS_CONTEXT_HPP
+
+#ifndef OPENGL_HPP_EGL
+#error "gl::HeadlessContext needs the library built with EGL (OPENGL_HPP_HEADLESS and an EGL install)"
+#endif
+
+#include "opengl.hpp"
+
+namespace gl {
+
+class HeadlessContext;
+
+struct HeadlessContextCreateInfo {
+    int majorVersion = 4;
+    int minorVersion = 5;
+    bool debug = false;
+    // objects are shared with this context, which must outlive the new one
+    const HeadlessContext *share = nullptr;
+    // also point glad's global entry points at this context
+    bool loadGlad = true;
+};
+
+// core profile context with no window, created through EGL on the surfaceless mesa platform when available
+// (llvmpipe or a gpu render node), falling back to the device platform and then the default display
+// there is no default framebuffer, render into a Framebuffer
+// only available when the library is built with EGL (OPENGL_HPP_EGL), including this header otherwise is an error
+class HeadlessContext {
+public:
+    explicit HeadlessContext(const HeadlessContextCreateInfo& createInfo = {});
+    ~HeadlessContext();
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    // contexts are current per thread
+    void makeCurrent() const;
+    void releaseCurrent() const;
+    // entry points resolved against this context
+    const Dispatch& getDispatch() const;
+
+    static void *getProcAddress(const char *name);
+
+private:
+    void destroy();
+
+private:
+    void *m_display;
+    void *m_context;
+    void *m_surface;
+    bool m_ownsDisplay;
+    Dispatch m_dispatch;
+};
+
+} // namespace gl
+
+#endif
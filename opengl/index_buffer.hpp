@@ -0,0 +1,53 @@
+#ifndef INDEX_BUFFER_HPP
+#define INDEX_BUFFER_HPP
+
+#include "opengl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gl {
+
+// smallest type that indexes vertexCount vertices and keeps its maximum value free as the primitive restart index
+// byte indices are valid gl but some hardware widens them in the driver, pass eUnsignedShort as smallest to avoid them
+IndexType selectIndexType(size_t vertexCount, IndexType smallest = IndexType::eUnsignedByte);
+size_t getIndexSize(IndexType type);
+// truncates 32 bit indices to type, 0xffffffff restart indices become the maximum of type
+void narrowIndices(void *dst, const uint32_t *indices, size_t indexCount, IndexType type);
+
+// an element buffer that knows its index type and count, so draws through it cannot pass a mismatching type
+class IndexBuffer {
+public:
+    IndexBuffer() = delete;
+    // picks the index type from vertexCount and uploads the narrowed indices with immutable storage
+    static IndexBuffer createIndexBuffer(const uint32_t *indices, size_t indexCount, size_t vertexCount, BufferStorage flags = BufferStorage::eNone,
+                                         IndexType smallest = IndexType::eUnsignedByte, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteIndexBuffer(IndexBuffer& indexBuffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    // makes this the element buffer of vertexArray, draws below read from the bound vertex array's element buffer
+    void attach(VertexArray& vertexArray, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER) const;
+
+    Buffer getBuffer() const;
+    IndexType getType() const;
+    size_t getCount() const;
+    // byte offset of index first, for the indirect and base vertex draws
+    size_t getOffset(size_t first) const;
+
+private:
+    IndexBuffer(Buffer buffer, IndexType type, size_t count);
+
+private:
+    Buffer m_buffer;
+    IndexType m_type;
+    size_t m_count;
+};
+
+// draws every index, the vertex array the buffer is attached to must be bound
+void drawElements(Primitive mode, const IndexBuffer& indexBuffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void drawElements(Primitive mode, const IndexBuffer& indexBuffer, size_t first, size_t count, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// draws every index instanceCount times, per instance attributes start at baseInstance
+void drawElementsInstanced(Primitive mode, const IndexBuffer& indexBuffer, size_t instanceCount, uint32_t baseInstance = 0, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+} // namespace gl
+
+#endif
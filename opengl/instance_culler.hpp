@@ -0,0 +1,108 @@
+#ifndef INSTANCE_CULLER_HPP
+#define INSTANCE_CULLER_HPP
+
+#include "depth_pyramid.hpp"
+#include "opengl.hpp"
+
+#include <cstdint>
+
+namespace gl {
+
+// a range of a shared index buffer that instances draw, baseVertex is added to every index
+struct InstanceMesh {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t baseVertex;
+};
+
+// world space bounds of an instance and the InstanceMesh it draws, laid out as the instance buffer holds them
+struct alignas(16) InstanceBounds {
+    float center[3];
+    float radius;
+    uint32_t mesh;
+};
+
+static_assert(sizeof(InstanceBounds) == 32);
+
+// culls a whole scene of instances on the gpu and draws the survivors with a single indirect count draw
+// each instance is tested against the frustum and optionally a DepthPyramid, usually built from last frame's depth,
+// the visible ones are compacted per mesh and each mesh with any gets one instanced DrawElementsIndirectCommand,
+// so draws scale with meshes rather than instances
+// the ids of a command's instances sit in the visible buffer from its baseInstance on, so per instance data is
+// fetched with instances[visible[gl_BaseInstance + gl_InstanceID]], or by binding the visible buffer as a uint
+// attribute with a binding divisor of 1 and using the id it yields
+// culling takes three dispatches, the test, a scan over the meshes in a single group and the scatter of the ids
+//
+// per frame:
+//   update moved instances with setInstances(), or write the instance buffer from a shader and issue a storage barrier
+//   cull(view), then bind the vertex array holding every mesh and a program, then draw()
+// matrices are column major and clip space is the default one, z in [-w, w] mapping to depth [0, 1]
+class InstanceCuller {
+public:
+    struct CreateInfo {
+        const InstanceMesh *meshes;
+        size_t meshCount;
+        // capacity of the instance and command buffers
+        size_t maxInstances;
+        IndexType indexType = IndexType::eUnsignedInt;
+        // the meshes, instances, commands, count and four internal buffers go to shader storage bindings
+        // firstBinding to firstBinding + 7
+        uint32_t firstBinding = 0;
+        uint32_t uniformBinding = 0;
+        // unit the pyramid is sampled from when occlusion culling
+        uint32_t textureUnit = 0;
+    };
+
+    struct View {
+        float viewProjection[16];
+        // nullptr skips occlusion culling, otherwise it must hold depth rendered with viewProjection or close to it,
+        // instances that were hidden last frame and came into view this frame show up a frame late
+        DepthPyramid *pyramid = nullptr;
+    };
+
+    explicit InstanceCuller(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~InstanceCuller();
+    InstanceCuller(const InstanceCuller&) = delete;
+    InstanceCuller& operator=(const InstanceCuller&) = delete;
+
+    // uploads count instances starting at first
+    void setInstances(size_t first, size_t count, const InstanceBounds *instances);
+    // instances past count are not culled or drawn
+    void setInstanceCount(size_t count);
+    // rewrites the commands, count and visible ids, leaves the program unbound and ends with command, storage and
+    // vertex attribute barriers
+    void cull(const View& view);
+    // binds the command and count buffers and issues every surviving draw, the vertex array must be bound
+    void draw(Primitive mode = Primitive::eTriangles);
+
+    // InstanceBounds, maxInstances of them
+    Buffer getInstanceBuffer() const;
+    // DrawElementsIndirectCommands, one slot per mesh
+    Buffer getCommandBuffer() const;
+    // a single uint holding the number of commands written
+    Buffer getCountBuffer() const;
+    // uint instance ids of the visible instances grouped by mesh, maxInstances of them
+    Buffer getVisibleBuffer() const;
+    size_t getInstanceCount() const;
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    size_t m_instanceCount;
+    Buffer m_meshes;
+    Buffer m_instances;
+    Buffer m_commands;
+    Buffer m_count;
+    Buffer m_meshCounts;
+    Buffer m_slots;
+    Buffer m_meshFirsts;
+    Buffer m_visible;
+    Buffer m_uniforms;
+    Program m_cull;
+    Program m_build;
+    Program m_scatter;
+};
+
+} // namespace gl
+
+#endif
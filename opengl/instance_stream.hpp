@@ -0,0 +1,63 @@
+#ifndef INSTANCE_STREAM_HPP
+#define INSTANCE_STREAM_HPP
+
+#include "opengl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gl {
+
+// per instance data, eg transforms, rewritten by the cpu every frame into a persistently mapped ring of frame slots
+// the whole ring is bound once as an instanced vertex buffer and each batch is selected with its baseInstance,
+// so a batch of any size costs one write into the mapping and one instanced draw
+// a fence per slot keeps the cpu from overwriting data the gpu may still read
+//
+// per frame:
+//   beginFrame()
+//   write a batch through allocate(count, baseInstance) and draw it with instanceCount = count and baseInstance
+//   endFrame() once the frame's draws are submitted
+// all calls must happen on the thread with the rendering context current
+class InstanceStream {
+public:
+    struct CreateInfo {
+        // bytes per instance, 64 for a mat4
+        size_t instanceSize;
+        // instances allocate() can hand out between two beginFrame() calls
+        size_t maxInstancesPerFrame;
+        // frames the gpu may lag behind before beginFrame() waits
+        uint32_t frameCount = 3;
+    };
+
+    explicit InstanceStream(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~InstanceStream();
+    InstanceStream(const InstanceStream&) = delete;
+    InstanceStream& operator=(const InstanceStream&) = delete;
+
+    // moves to the next slot, waiting for the gpu to finish the frame that last used it
+    void beginFrame();
+    // count instances of instanceSize bytes to be written before the draws that read them are issued
+    // baseInstance receives the value to draw them with, throws when the frame's slot is full
+    void *allocate(size_t count, uint32_t& baseInstance);
+    // fences the current slot
+    void endFrame();
+
+    // sets the ring as bindingIndex of vertexArray with a divisor of 1, only needed once per vertex array
+    // the attributes reading it still need attribFormat and attribBinding, a mat4 takes four vec4 locations
+    void bind(VertexArray& vertexArray, uint32_t bindingIndex) const;
+    Buffer getBuffer() const;
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    Buffer m_buffer;
+    uint8_t *m_mapped;
+    uint32_t m_frame;
+    size_t m_head;
+    std::vector<GLsync> m_fences;
+};
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef MESH_OPTIMIZER_HPP
+#define MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gl {
+
+// offline reordering of triangle lists before they reach drawElements, all cpu side and independent of a context
+// the usual order is optimizeVertexCache, then optionally optimizeOverdraw, then optimizeVertexFetch
+
+struct VertexCacheStats {
+    size_t transformedVertices;
+    size_t triangleCount;
+    size_t uniqueVertices;
+    // transformed vertices per triangle, 0.5 is the best a regular grid can reach and 3 the worst
+    float acmr;
+    // transformed vertices per referenced vertex, 1 is optimal
+    float atvr;
+};
+
+// simulates a fifo post transform cache of cacheSize entries
+VertexCacheStats analyzeVertexCache(const uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = 16);
+
+// tom forsyth's linear speed vertex cache optimisation, works well without knowing the hardware cache size
+// dst must not alias indices
+void optimizeVertexCache(uint32_t *dst, const uint32_t *indices, size_t indexCount, size_t vertexCount);
+// sander et al's tipsify, faster than forsyth and tuned to a fifo cache of cacheSize entries
+void optimizeVertexCacheTipsify(uint32_t *dst, const uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = 16);
+
+// splits a cache optimised index list into clusters and draws the outward facing ones at the rim first, so early
+// depth rejection discards more of what is behind them, positions are 3 floats at positionStride bytes
+// threshold bounds how much acmr the extra cluster cuts may cost, 1.05 allows 5%
+// dst must not alias indices
+void optimizeOverdraw(uint32_t *dst, const uint32_t *indices, size_t indexCount, const float *positions, size_t vertexCount, size_t positionStride, float threshold = 1.05f);
+
+// numbers vertices in the order the indices first use them and rewrites the indices to match
+// remap receives vertexCount entries, unused vertices map to UINT32_MAX, returns the number of used vertices
+size_t optimizeVertexFetchRemap(uint32_t *remap, uint32_t *indices, size_t indexCount, size_t vertexCount);
+// gathers vertexSize byte vertices into their remapped slots, dst must not alias src
+void remapVertices(void *dst, const void *src, size_t vertexCount, size_t vertexSize, const uint32_t *remap);
+// both of the above in place, returns the new vertex count
+size_t optimizeVertexFetch(uint32_t *indices, size_t indexCount, void *vertices, size_t vertexCount, size_t vertexSize);
+
+} // namespace gl
+
+#endif
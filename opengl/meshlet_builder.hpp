@@ -0,0 +1,48 @@
+#ifndef MESHLET_BUILDER_HPP
+#define MESHLET_BUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gl {
+
+// splits triangle lists into small clusters that can be culled on their own, all cpu side and independent of a context
+// indices keep referring to the original vertices, a meshlet is just a contiguous range of the rebuilt index list
+
+struct Meshlet {
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    // distinct vertices the range references
+    uint32_t vertexCount;
+};
+
+struct MeshletBounds {
+    // bounding sphere of the meshlet's vertices
+    float center[3];
+    float radius;
+    // every triangle's normal lies within acos(coneCutoff) of coneAxis, when the spread is too wide to ever
+    // cull coneCutoff is 1 and the test below never passes
+    // the meshlet faces away from a camera at c when dot(center - c, coneAxis) >= coneCutoff * length(center - c) + radius
+    float coneAxis[3];
+    float coneCutoff;
+};
+
+struct MeshletMesh {
+    std::vector<Meshlet> meshlets;
+    std::vector<MeshletBounds> bounds;
+    std::vector<uint32_t> indices;
+};
+
+// greedily walks the triangles in order, starting a new meshlet whenever one would pass maxVertices or maxTriangles
+// run optimizeVertexCache first, its locality is what keeps meshlets compact and full
+// positions are 3 floats at positionStride bytes
+MeshletMesh buildMeshlets(const uint32_t *indices, size_t indexCount, const float *positions, size_t vertexCount, size_t positionStride,
+                          uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+
+// bounds of any triangle list, buildMeshlets calls this for every meshlet
+MeshletBounds computeMeshletBounds(const uint32_t *indices, size_t indexCount, const float *positions, size_t vertexCount, size_t positionStride);
+
+} // namespace gl
+
+#endif
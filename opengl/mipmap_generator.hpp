@@ -0,0 +1,84 @@
+#ifndef MIPMAP_GENERATOR_HPP
+#define MIPMAP_GENERATOR_HPP
+
+#include "opengl.hpp"
+#include "worker_pool.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gl {
+
+enum class MipFilter {
+    // 2x2 average
+    eBox,
+    // 8 tap kaiser windowed sinc, sharper than box at the cost of a float pass
+    eKaiser,
+};
+
+// the functions below use avx2 (picked at runtime on x86) or neon where available and fall back to scalar code
+
+// expands eRGB, eBGR, eBGRA or eRGBA unsigned byte pixels to tightly packed rgba8
+void convertToRGBA8(Format format, const uint8_t *src, uint8_t *dst, size_t pixelCount);
+// full chain down to 1x1
+uint32_t getMipLevelCount(uint32_t width, uint32_t height);
+// bytes of a tightly packed rgba8 chain, levels are stored one after the other starting with the largest
+size_t getMipChainSize(uint32_t width, uint32_t height, uint32_t levels);
+// halves a tightly packed rgba8 image, odd sizes round down and never go below 1
+// with srgb the color channels are filtered in linear space, alpha is always linear
+void downsampleRGBA8(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst, MipFilter filter, bool srgb);
+// writes getMipChainSize(width, height, levels) bytes to dst, level 0 is copied from src
+void generateMipChain(const uint8_t *src, uint32_t width, uint32_t height, uint32_t levels, uint8_t *dst, MipFilter filter, bool srgb);
+
+// builds complete mip chains for uploaded images on cpu threads instead of glGenerateTextureMipmap,
+// so the work overlaps with loading and the gpu only sees plain copies
+// each add() queues one task that converts the image and writes every level into a persistently mapped
+// staging buffer, upload() waits for those tasks and records one glTextureSubImage2D per level
+// all calls must happen on the thread with the rendering context current
+class MipmapGenerator {
+public:
+    struct CreateInfo {
+        MipFilter filter = MipFilter::eBox;
+        // every chain queued between two upload() calls has to fit, larger ones throw
+        size_t stagingSize = 64 << 20;
+        // 0 uses std::thread::hardware_concurrency
+        size_t threadCount = 0;
+    };
+
+    explicit MipmapGenerator(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~MipmapGenerator();
+    MipmapGenerator(const MipmapGenerator&) = delete;
+    MipmapGenerator& operator=(const MipmapGenerator&) = delete;
+
+    // creates the texture with storage for the full chain and queues the cpu work, the caller owns the texture
+    // format is one of the convertToRGBA8 formats with unsigned byte texels, pixels must stay valid until upload()
+    Texture add(uint32_t width, uint32_t height, Format format, const void *pixels, bool srgb = false);
+    // waits for the queued chains and copies them into their textures
+    void upload();
+
+private:
+    struct PendingUpload {
+        Texture texture;
+        uint32_t width;
+        uint32_t height;
+        uint32_t levels;
+        size_t offset;
+    };
+
+    // waits for the previous copies out of the staging buffer when it has to wrap
+    size_t allocateStaging(size_t size);
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    WorkerPool m_pool;
+    Buffer m_staging;
+    uint8_t *m_mapped;
+    size_t m_head = 0;
+    GLsync m_fence = nullptr;
+    std::vector<PendingUpload> m_pending;
+};
+
+} // namespace gl
+
+#endif
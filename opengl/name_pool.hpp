@@ -0,0 +1,104 @@
+#ifndef NAME_POOL_HPP
+#define NAME_POOL_HPP
+
+#include "opengl.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace gl {
+
+// the extra creation argument of pools whose objects need none
+struct NoPoolKey {};
+
+template <typename T>
+struct NamePoolTraits;
+
+template <>
+struct NamePoolTraits<Buffer> {
+    using Key = NoPoolKey;
+    static std::vector<Buffer> create(NoPoolKey, size_t count) {
+        return Buffer::createBuffers(count);
+    }
+    static void destroy(size_t count, Buffer *buffers) {
+        Buffer::deleteBuffers(count, buffers);
+    }
+};
+
+template <>
+struct NamePoolTraits<VertexArray> {
+    using Key = NoPoolKey;
+    static std::vector<VertexArray> create(NoPoolKey, size_t count) {
+        return VertexArray::createVertexArrays(count);
+    }
+    static void destroy(size_t count, VertexArray *vertexArrays) {
+        VertexArray::deleteVertexArrays(count, vertexArrays);
+    }
+};
+
+// textures are created for one target, so a texture pool is keyed by its TextureType
+template <>
+struct NamePoolTraits<Texture> {
+    using Key = TextureType;
+    static std::vector<Texture> create(TextureType type, size_t count) {
+        return Texture::createTextures(type, count);
+    }
+    static void destroy(size_t count, Texture *textures) {
+        Texture::deleteTextures(count, textures);
+    }
+};
+
+// hands out object names created ahead of time in blocks, so acquire() is usually a vector pop
+// released objects keep their state, only release objects that can be respecified,
+// eg a buffer or texture that was given immutable storage must be deleted instead
+template <typename T>
+class NamePool {
+public:
+    using Key = typename NamePoolTraits<T>::Key;
+
+    explicit NamePool(size_t blockSize = 1024) : m_key(), m_blockSize(blockSize) {
+        static_assert(std::is_same_v<Key, NoPoolKey>, "this pool needs its key, eg the TextureType of a texture pool");
+    }
+    explicit NamePool(Key key, size_t blockSize = 1024) : m_key(key), m_blockSize(blockSize) {}
+    ~NamePool() {
+        NamePoolTraits<T>::destroy(m_free.size(), m_free.data());
+    }
+    NamePool(const NamePool&) = delete;
+    NamePool& operator=(const NamePool&) = delete;
+
+    T acquire() {
+        if (m_free.empty()) {
+            reserve(m_blockSize);
+        }
+        T object = m_free.back();
+        m_free.pop_back();
+        return object;
+    }
+    void release(T object) {
+        m_free.push_back(object);
+    }
+    // makes sure at least count names can be acquired without creating more
+    void reserve(size_t count) {
+        if (m_free.size() >= count) {
+            return;
+        }
+        std::vector<T> created = NamePoolTraits<T>::create(m_key, count - m_free.size());
+        m_free.insert(m_free.end(), created.begin(), created.end());
+    }
+    size_t available() const {
+        return m_free.size();
+    }
+
+private:
+    Key m_key;
+    size_t m_blockSize;
+    std::vector<T> m_free;
+};
+
+using BufferPool = NamePool<Buffer>;
+using VertexArrayPool = NamePool<VertexArray>;
+using TexturePool = NamePool<Texture>;
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef OFFSCREEN_RENDERER_HPP
+#define OFFSCREEN_RENDERER_HPP
+
+#include "opengl.hpp"
+#include "worker_pool.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace gl {
+
+// tightly packed rgba8 pixels, top row first
+struct Image {
+    uint64_t jobId;
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint8_t> pixels;
+};
+
+std::vector<uint8_t> encodePNG(const Image& image);
+void writePNG(const std::string& filePath, const Image& image);
+
+// renders jobs into an offscreen framebuffer as a three stage pipeline:
+// job N renders while job N-1 is read back through a pixel pack buffer and job N-2 is encoded on a worker pool
+// queues between the stages are bounded, so throughput is set by the slowest stage
+// all calls must happen on the thread with the rendering context current
+class OffscreenRenderer {
+public:
+    // issues the draw calls for a job, the framebuffer and viewport are already bound
+    using RenderCallback = std::function<void(uint64_t jobId)>;
+    // runs on a worker thread, eg writePNG
+    using EncodeCallback = std::function<void(Image&& image)>;
+
+    struct CreateInfo {
+        uint32_t width;
+        uint32_t height;
+        EncodeCallback encode;
+        // readbacks that may be in flight on the gpu before submit() waits for the oldest
+        size_t readbackSlots = 2;
+        size_t encodeThreads = 0;
+        size_t encodeQueueCapacity = 4;
+        bool depth = true;
+    };
+
+    explicit OffscreenRenderer(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~OffscreenRenderer();
+    OffscreenRenderer(const OffscreenRenderer&) = delete;
+    OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+
+    void submit(uint64_t jobId, const RenderCallback& render);
+    // waits for every submitted job to be read back and encoded, rethrows the first exception an encode threw
+    void finish();
+
+private:
+    struct ReadbackSlot {
+        Buffer buffer;
+        const uint8_t *mapped;
+        GLsync fence;
+        uint64_t jobId;
+    };
+
+    // copies a finished readback out of its slot and hands it to the encoders
+    void retire(ReadbackSlot& slot, bool wait);
+    void retireAll();
+
+private:
+    const Dispatch *m_dispatch;
+    uint32_t m_width;
+    uint32_t m_height;
+    EncodeCallback m_encode;
+    Framebuffer m_framebuffer;
+    Renderbuffer m_color;
+    // only created when CreateInfo::depth is set
+    std::optional<Renderbuffer> m_depth;
+    std::vector<ReadbackSlot> m_slots;
+    size_t m_nextSlot = 0;
+    WorkerPool m_encoders;
+};
+
+} // namespace gl
+
+#endif
@@ -1,28 +1,80 @@
 #ifndef OPENGL_HPP
 #define OPENGL_HPP
 
+#include "dispatch.hpp"
 #include "types.hpp"
 
+#include <deque>
+#include <vector>
+
+// define OPENGL_HPP_INLINE to get the wrappers as inline functions in every translation unit
+// instead of out of line calls into the compiled library
+#ifdef OPENGL_HPP_INLINE
+#define OPENGL_HPP_FUNC inline
+#else
+#define OPENGL_HPP_FUNC
+#endif
+
 namespace gl {
 
+template <typename T>
+class UniqueHandle;
+
+class Buffer;
+class VertexArray;
+class Shader;
+class Program;
+class ProgramPipeline;
+class Renderbuffer;
+class Texture;
+class Framebuffer;
+
+using UniqueBuffer = UniqueHandle<Buffer>;
+using UniqueVertexArray = UniqueHandle<VertexArray>;
+using UniqueShader = UniqueHandle<Shader>;
+using UniqueProgram = UniqueHandle<Program>;
+using UniqueProgramPipeline = UniqueHandle<ProgramPipeline>;
+using UniqueRenderbuffer = UniqueHandle<Renderbuffer>;
+using UniqueTexture = UniqueHandle<Texture>;
+using UniqueFramebuffer = UniqueHandle<Framebuffer>;
+
 class Buffer {
 public:
+    static constexpr ObjectType objectType = ObjectType::eBuffer;
+
     Buffer() = delete;
-    static Buffer createBuffer();
-    static void deleteBuffer(Buffer& buffer);
-    static void copySubData(Buffer& readBuffer, Buffer& writeBuffer, size_t readOffset, size_t writeOffset, size_t size);
-
-    void storage(size_t size, const void *data, BufferStorage flags);
-    void data(size_t size, const void *data, BufferUsage usage);
-    void subData(size_t offset, size_t size, const void *data);
-    void getSubData(size_t offset, size_t size, void *data);
-    void *mapRange(size_t offset, size_t length, BufferMap access);
-    void flushRange(size_t offset, size_t length);
-    void unmap();
-    void invalidateData();
-    void invalidateSubData(size_t offset, size_t length);
+    static Buffer createBuffer(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueBuffer createBufferUnique(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // creates count buffers with a single glCreateBuffers
+    static std::vector<Buffer> createBuffers(size_t count, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteBuffer(Buffer& buffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteBuffers(size_t count, Buffer *buffers, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void copySubData(Buffer& readBuffer, Buffer& writeBuffer, size_t readOffset, size_t writeOffset, size_t size, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void unbind(BufferTarget target, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // binds count buffers to the consecutive binding points starting at first in one call
+    static void bindBuffersBase(IndexedBufferTarget target, uint32_t first, size_t count, const Buffer *buffers, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void bindBuffersRange(IndexedBufferTarget target, uint32_t first, size_t count, const Buffer *buffers, const size_t *offsets, const size_t *sizes, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    void bind(BufferTarget target, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void bindBase(IndexedBufferTarget target, uint32_t index, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // offset must respect the target's offset alignment, eg GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+    void bindRange(IndexedBufferTarget target, uint32_t index, size_t offset, size_t size, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void storage(size_t size, const void *data, BufferStorage flags, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void data(size_t size, const void *data, BufferUsage usage, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void subData(size_t offset, size_t size, const void *data, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void getSubData(size_t offset, size_t size, void *data, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void *mapRange(size_t offset, size_t length, BufferMap access, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void flushRange(size_t offset, size_t length, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void unmap(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void invalidateData(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void invalidateSubData(size_t offset, size_t length, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // only for BufferStorage::eSparse buffers, offset and size must be page aligned
+    void pageCommitment(size_t offset, size_t size, bool commit, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
 
     friend class VertexArray;
+    friend class BarrierTracker;
+    friend class BufferRangeTable;
+    template <typename> friend class UniqueHandle;
 
 private:
     Buffer(GLuint id);
@@ -31,20 +83,53 @@ private:
     GLuint m_id;
 };
 
+// a prebuilt set of ranges bound to consecutive binding points with a single glBindBuffersRange
+// build it once and call bind() before every dispatch or draw that needs it
+class BufferRangeTable {
+public:
+    BufferRangeTable(IndexedBufferTarget target, uint32_t first);
+
+    // slots past the current end grow the table, unset slots bind buffer 0
+    void set(uint32_t slot, Buffer& buffer, size_t offset, size_t size);
+    void clear();
+    void bind(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+private:
+    IndexedBufferTarget m_target;
+    uint32_t m_first;
+    std::vector<GLuint> m_buffers;
+    std::vector<GLintptr> m_offsets;
+    std::vector<GLsizeiptr> m_sizes;
+};
+
 class VertexArray {
 public:
+    static constexpr ObjectType objectType = ObjectType::eVertexArray;
+
     VertexArray() = delete;
-    static VertexArray createVertexArray();
-    static void deleteVertexArray(VertexArray& vertexArray);
-    static void unbind();
+    static VertexArray createVertexArray(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueVertexArray createVertexArrayUnique(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // creates count vertex arrays with a single glCreateVertexArrays
+    static std::vector<VertexArray> createVertexArrays(size_t count, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteVertexArray(VertexArray& vertexArray, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteVertexArrays(size_t count, VertexArray *vertexArrays, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void unbind(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
 
-    void bind();
-    void enableAttrib(uint32_t index);
-    void disableAttrib(uint32_t index);
-    void attribBinding(uint32_t location, uint32_t bindingIndex);
-    void attribFormat(uint32_t location, int32_t size, Type type, bool normalised, uint32_t relativeOffset);
-    void vertexBuffer(uint32_t bindingIndex, Buffer& buffer, size_t offset, size_t stride);
-    void elementBuffer(Buffer& buffer);
+    void bind(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void enableAttrib(uint32_t index, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void disableAttrib(uint32_t index, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void attribBinding(uint32_t location, uint32_t bindingIndex, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void attribFormat(uint32_t location, int32_t size, Type type, bool normalised, uint32_t relativeOffset, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // integer attributes read as ivec/uvec in the shader, type must be one of the integer types
+    void attribIFormat(uint32_t location, int32_t size, Type type, uint32_t relativeOffset, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // double attributes read as double/dvec in the shader, type must be Type::eDouble
+    void attribLFormat(uint32_t location, int32_t size, Type type, uint32_t relativeOffset, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void vertexBuffer(uint32_t bindingIndex, Buffer& buffer, size_t offset, size_t stride, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // attributes on bindingIndex advance once every divisor instances instead of every vertex, 0 makes them per vertex again
+    void bindingDivisor(uint32_t bindingIndex, uint32_t divisor, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void elementBuffer(Buffer& buffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    template <typename> friend class UniqueHandle;
 
 private:
     VertexArray(GLuint id);
@@ -55,15 +140,22 @@ private:
 
 class Shader {
 public:
-    static Shader createShader(ShaderType type);
-    static void deleteShader(Shader& shader); 
+    static constexpr ObjectType objectType = ObjectType::eShader;
+
+    static Shader createShader(ShaderType type, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueShader createShaderUnique(ShaderType type, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteShader(Shader& shader, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER); 
 
-    void source(size_t count, const char *const string, const int *length);
-    void compile();
-    int getiv(ShaderIV pname);
-    std::string getInfoLog();
+    void source(size_t count, const char *const string, const int *length, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void compile(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void binary(ShaderBinaryFormat format, const void *binary, size_t length, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // replaces compile() for spirv modules, indices and values hold count specialization constants
+    void specialize(const char *entryPoint, size_t count, const uint32_t *indices, const uint32_t *values, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    int getiv(ShaderIV pname, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    std::string getInfoLog(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
 
     friend class Program;
+    template <typename> friend class UniqueHandle;
 
 private:
     Shader(GLuint id);
@@ -74,15 +166,24 @@ private:
 
 class Program {
 public:
-    static Program createProgram();
-    static void deleteProgram(Program& program);
-    static void useNone();  // unbind program
+    static constexpr ObjectType objectType = ObjectType::eProgram;
 
-    void use();
-    void attachShader(Shader& shader);
-    void link();
-    int getiv(ProgramIV pname);
-    std::string getInfoLog();
+    static Program createProgram(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueProgram createProgramUnique(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // compiles and links a single stage separable program in one call
+    static Program createShaderProgram(ShaderType type, size_t count, const char *const string, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteProgram(Program& program, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void useNone(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);  // unbind program
+
+    void use(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void attachShader(Shader& shader, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void parameter(ProgramParameter pname, int value, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void link(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    int getiv(ProgramIV pname, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    std::string getInfoLog(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    friend class ProgramPipeline;
+    template <typename> friend class UniqueHandle;
 
 public:
     Program(GLuint id);
@@ -91,13 +192,274 @@ private:
     GLuint m_id;
 };
 
-void clearColor(float r, float g, float b, float a);
-void clear(ClearBufferBits mask);
-void enable(Capabilities capability);
-void disable(Capabilities capability);
-void drawArrays(Primitive mode, int32_t first, size_t count);
-void drawElements(Primitive mode, size_t count, Type type, const void *indices);
+class ProgramPipeline {
+public:
+    static constexpr ObjectType objectType = ObjectType::eProgramPipeline;
+
+    ProgramPipeline() = delete;
+    static ProgramPipeline createProgramPipeline(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueProgramPipeline createProgramPipelineUnique(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteProgramPipeline(ProgramPipeline& programPipeline, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void unbind(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    void bind(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // program must have been linked with ProgramParameter::eSeparable set
+    void useProgramStages(ProgramStage stages, Program& program, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void activeShaderProgram(Program& program, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void validate(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    int getiv(ProgramPipelineIV pname, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    std::string getInfoLog(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    template <typename> friend class UniqueHandle;
+
+private:
+    ProgramPipeline(GLuint id);
+
+private:
+    GLuint m_id;
+};
+
+class Renderbuffer {
+public:
+    static constexpr ObjectType objectType = ObjectType::eRenderbuffer;
+
+    Renderbuffer() = delete;
+    static Renderbuffer createRenderbuffer(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueRenderbuffer createRenderbufferUnique(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteRenderbuffer(Renderbuffer& renderbuffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    void storage(InternalFormat internalFormat, uint32_t width, uint32_t height, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void storageMultisample(uint32_t samples, InternalFormat internalFormat, uint32_t width, uint32_t height, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    friend class Framebuffer;
+    template <typename> friend class UniqueHandle;
+
+private:
+    Renderbuffer(GLuint id);
+
+private:
+    GLuint m_id;
+};
+
+class Texture {
+public:
+    static constexpr ObjectType objectType = ObjectType::eTexture;
+
+    Texture() = delete;
+    static Texture createTexture(TextureType type, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueTexture createTextureUnique(TextureType type, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // creates count textures with a single glCreateTextures
+    static std::vector<Texture> createTextures(TextureType type, size_t count, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteTexture(Texture& texture, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteTextures(size_t count, Texture *textures, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    void bindUnit(uint32_t unit, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void bindImage(uint32_t unit, int32_t level, bool layered, int32_t layer, ImageAccess access, InternalFormat format, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void parameter(TextureParameter pname, int value, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void storage1D(uint32_t levels, InternalFormat internalFormat, uint32_t width, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void storage2D(uint32_t levels, InternalFormat internalFormat, uint32_t width, uint32_t height, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // depth is the layer count for array textures
+    void storage3D(uint32_t levels, InternalFormat internalFormat, uint32_t width, uint32_t height, uint32_t depth, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // pixels is an offset when a BufferTarget::ePixelUnpack buffer is bound
+    void subImage2D(int32_t level, int32_t x, int32_t y, uint32_t width, uint32_t height, Format format, Type type, const void *pixels, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void subImage3D(int32_t level, int32_t x, int32_t y, int32_t z, uint32_t width, uint32_t height, uint32_t depth, Format format, Type type, const void *pixels, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // data holds imageSize bytes of blocks in format, which must match the storage format
+    // data is an offset when a BufferTarget::ePixelUnpack buffer is bound
+    void compressedSubImage2D(int32_t level, int32_t x, int32_t y, uint32_t width, uint32_t height, InternalFormat format, size_t imageSize, const void *data, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // cube map faces are layers 0 to 5
+    void compressedSubImage3D(int32_t level, int32_t x, int32_t y, int32_t z, uint32_t width, uint32_t height, uint32_t depth, InternalFormat format, size_t imageSize, const void *data, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // data is a single texel, nullptr clears to zero
+    void clearImage(int32_t level, Format format, Type type, const void *data, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void generateMipmap(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // only for TextureParameter::eSparse textures, the region must be a multiple of the virtual page size
+    // ARB_sparse_texture has no direct state access entry point in core profiles, so this binds the texture to type
+    void pageCommitment(TextureType type, int32_t level, int32_t x, int32_t y, int32_t z, uint32_t width, uint32_t height, uint32_t depth, bool commit, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    friend class Framebuffer;
+    friend class BarrierTracker;
+    template <typename> friend class UniqueHandle;
+
+private:
+    Texture(GLuint id);
+
+private:
+    GLuint m_id;
+};
+
+class Framebuffer {
+public:
+    static constexpr ObjectType objectType = ObjectType::eFramebuffer;
+
+    Framebuffer() = delete;
+    static Framebuffer createFramebuffer(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static UniqueFramebuffer createFramebufferUnique(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void deleteFramebuffer(Framebuffer& framebuffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    static void unbind(FramebufferTarget target, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);  // binds the default framebuffer
+    static void blit(Framebuffer& readFramebuffer, Framebuffer& drawFramebuffer, int32_t srcX0, int32_t srcY0, int32_t srcX1, int32_t srcY1, int32_t dstX0, int32_t dstY0, int32_t dstX1, int32_t dstY1, ClearBufferBits mask, Filter filter, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    void bind(FramebufferTarget target, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void renderbuffer(FramebufferAttachment attachment, Renderbuffer& renderbuffer, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void texture(FramebufferAttachment attachment, Texture& texture, int32_t level, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // value holds four components, drawBuffer indexes the drawBuffers() list
+    void clearColor(int32_t drawBuffer, const float *value, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void clearColor(int32_t drawBuffer, const uint32_t *value, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void clearDepth(float depth, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void drawBuffers(size_t count, const FramebufferAttachment *attachments, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    void readBuffer(FramebufferAttachment attachment, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    FramebufferStatus checkStatus(FramebufferTarget target, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+    template <typename> friend class UniqueHandle;
+
+private:
+    Framebuffer(GLuint id);
+
+private:
+    GLuint m_id;
+};
+
+// holds names released by unique handles until the gpu is done with the frame that last used them
+// names released during a frame are deleted together, one glDelete* call per object type
+// must be used and destroyed on the thread that has its context current
+class DeletionQueue {
+public:
+    explicit DeletionQueue(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~DeletionQueue();
+    DeletionQueue(const DeletionQueue&) = delete;
+    DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+    // unique handles destroyed on this thread go to queue, nullptr deletes them immediately through the default dispatcher
+    static void setCurrent(DeletionQueue *queue);
+    static DeletionQueue *getCurrent();
+    static void defer(ObjectType type, GLuint id);
+
+    void push(ObjectType type, GLuint id);
+    // call after the frame's commands are submitted, fences the names released since the previous call
+    // and deletes any earlier batches whose fence has signaled, never blocks
+    void endFrame();
+    // waits for every outstanding batch and deletes it
+    void flush();
+
+private:
+    struct Batch {
+        GLsync fence = nullptr;
+        std::vector<GLuint> buffers;
+        std::vector<GLuint> vertexArrays;
+        std::vector<GLuint> shaders;
+        std::vector<GLuint> programs;
+        std::vector<GLuint> programPipelines;
+        std::vector<GLuint> renderbuffers;
+        std::vector<GLuint> textures;
+        std::vector<GLuint> framebuffers;
+    };
+
+    static std::vector<GLuint>& names(Batch& batch, ObjectType type);
+    static void deleteBatch(Batch& batch, const Dispatch& d);
+
+private:
+    const Dispatch *m_dispatch;
+    Batch m_current;
+    std::deque<Batch> m_inFlight;
+};
+
+// move only owner of a gl object, the same size as the name it wraps
+template <typename T>
+class UniqueHandle {
+public:
+    UniqueHandle() : m_value(0) {}
+    explicit UniqueHandle(T value) : m_value(value) {}
+    ~UniqueHandle() {
+        reset();
+    }
+    UniqueHandle(const UniqueHandle&) = delete;
+    UniqueHandle& operator=(const UniqueHandle&) = delete;
+    // noexcept so std::vector moves handles when it reallocates instead of trying to copy them
+    UniqueHandle(UniqueHandle&& other) noexcept : m_value(other.release()) {}
+    UniqueHandle& operator=(UniqueHandle&& other) noexcept {
+        reset(other.release());
+        return *this;
+    }
+
+    T& get() {
+        return m_value;
+    }
+    T& operator*() {
+        return m_value;
+    }
+    T *operator->() {
+        return &m_value;
+    }
+    explicit operator bool() const {
+        return m_value.m_id != 0;
+    }
+    // gives up ownership without deleting
+    T release() noexcept {
+        T value = m_value;
+        m_value.m_id = 0;
+        return value;
+    }
+    void reset(T value = T(0)) {
+        if (m_value.m_id != 0 && m_value.m_id != value.m_id) {
+            DeletionQueue::defer(T::objectType, m_value.m_id);
+        }
+        m_value = value;
+    }
+
+private:
+    T m_value;
+};
+
+static_assert(sizeof(UniqueBuffer) == sizeof(GLuint));
+static_assert(sizeof(UniqueVertexArray) == sizeof(GLuint));
+static_assert(sizeof(UniqueShader) == sizeof(GLuint));
+static_assert(sizeof(UniqueProgram) == sizeof(GLuint));
+static_assert(sizeof(UniqueProgramPipeline) == sizeof(GLuint));
+static_assert(sizeof(UniqueRenderbuffer) == sizeof(GLuint));
+static_assert(sizeof(UniqueTexture) == sizeof(GLuint));
+static_assert(sizeof(UniqueFramebuffer) == sizeof(GLuint));
+static_assert(std::is_nothrow_move_constructible_v<UniqueBuffer>);
+static_assert(std::is_nothrow_move_assignable_v<UniqueBuffer>);
+
+// layout of the commands read by the indirect element draws
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+void clearColor(float r, float g, float b, float a, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void clear(ClearBufferBits mask, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void viewport(int32_t x, int32_t y, uint32_t width, uint32_t height, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// reads from the bound read framebuffer, data is an offset when a BufferTarget::ePixelPack buffer is bound
+void readPixels(int32_t x, int32_t y, uint32_t width, uint32_t height, Format format, Type type, void *data, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void enable(Capabilities capability, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void disable(Capabilities capability, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void drawArrays(Primitive mode, int32_t first, size_t count, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void drawElements(Primitive mode, size_t count, Type type, const void *indices, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void drawElements(Primitive mode, size_t count, IndexType type, const void *indices, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// per instance attributes start at baseInstance, gl_InstanceID still counts from 0
+void drawArraysInstancedBaseInstance(Primitive mode, int32_t first, size_t count, size_t instanceCount, uint32_t baseInstance, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// baseVertex is added to every index before fetching vertices
+void drawElementsInstancedBaseVertexBaseInstance(Primitive mode, size_t count, IndexType type, const void *indices, size_t instanceCount, int32_t baseVertex,
+                                                 uint32_t baseInstance, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// reads drawCount commands, stride bytes apart, from offset in the buffer bound to BufferTarget::eDrawIndirect
+// stride 0 means tightly packed DrawElementsIndirectCommands
+void multiDrawElementsIndirect(Primitive mode, IndexType type, size_t offset, size_t drawCount, size_t stride, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// as above with the draw count read from countOffset in the buffer bound to BufferTarget::eParameter, clamped to maxDrawCount
+void multiDrawElementsIndirectCount(Primitive mode, IndexType type, size_t offset, size_t countOffset, size_t maxDrawCount, size_t stride, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void dispatchCompute(uint32_t numGroupsX, uint32_t numGroupsY, uint32_t numGroupsZ, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// reads the group counts from the buffer bound to BufferTarget::eDispatchIndirect
+void dispatchComputeIndirect(size_t offset, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void memoryBarrier(MemoryBarrierBits barriers, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+void memoryBarrierByRegion(MemoryBarrierBits barriers, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+// name is the full extension string, eg "GL_ARB_sparse_buffer"
+bool isExtensionSupported(const char *name, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
 
 } // namespace gl
 
+#ifdef OPENGL_HPP_INLINE
+#include "opengl.inl"
+#endif
+
 #endif
\ No newline at end of file
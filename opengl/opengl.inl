@@ -0,0 +1,770 @@
+#ifndef OPENGL_INL
+#define OPENGL_INL
+
+// definitions of the wrappers declared in opengl.hpp
+// compiled once by src/opengl.cpp, or included by opengl.hpp when OPENGL_HPP_INLINE is defined
+
+#include "opengl.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace gl {
+
+OPENGL_HPP_FUNC Buffer::Buffer(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC Buffer Buffer::createBuffer(const Dispatch& d) {
+    GLuint id;
+    d.glCreateBuffers(1, &id);
+    return {id};
+}
+
+OPENGL_HPP_FUNC UniqueBuffer Buffer::createBufferUnique(const Dispatch& d) {
+    return UniqueBuffer(createBuffer(d));
+}
+
+OPENGL_HPP_FUNC std::vector<Buffer> Buffer::createBuffers(size_t count, const Dispatch& d) {
+    std::vector<GLuint> ids(count);
+    d.glCreateBuffers(count, ids.data());
+    std::vector<Buffer> objects;
+    objects.reserve(count);
+    for (GLuint id : ids) {
+        objects.push_back(Buffer(id));
+    }
+    return objects;
+}
+
+OPENGL_HPP_FUNC void Buffer::deleteBuffer(Buffer& buffer, const Dispatch& d) {
+    d.glDeleteBuffers(1, &buffer.m_id);
+    buffer.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void Buffer::deleteBuffers(size_t count, Buffer *buffers, const Dispatch& d) {
+    std::vector<GLuint> ids(count);
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = buffers[i].m_id;
+        buffers[i].m_id = 0;
+    }
+    d.glDeleteBuffers(count, ids.data());
+}
+
+OPENGL_HPP_FUNC void Buffer::copySubData(Buffer& readBuffer, Buffer& writeBuffer, size_t readOffset, size_t writeOffset, size_t size, const Dispatch& d) {
+    d.glCopyNamedBufferSubData(readBuffer.m_id, writeBuffer.m_id, readOffset, writeOffset, size);
+}
+
+OPENGL_HPP_FUNC void Buffer::unbind(BufferTarget target, const Dispatch& d) {
+    d.glBindBuffer(static_cast<GLenum>(target), 0);
+}
+
+OPENGL_HPP_FUNC void Buffer::bindBuffersBase(IndexedBufferTarget target, uint32_t first, size_t count, const Buffer *buffers, const Dispatch& d) {
+    // converted on the stack in batches, binding is too hot for a heap allocation per call
+    constexpr size_t batch = 16;
+    GLuint ids[batch];
+    for (size_t start = 0; start < count; start += batch) {
+        size_t n = std::min(count - start, batch);
+        for (size_t i = 0; i < n; i++) {
+            ids[i] = buffers[start + i].m_id;
+        }
+        d.glBindBuffersBase(static_cast<GLenum>(target), first + start, n, ids);
+    }
+}
+
+OPENGL_HPP_FUNC void Buffer::bindBuffersRange(IndexedBufferTarget target, uint32_t first, size_t count, const Buffer *buffers, const size_t *offsets, const size_t *sizes, const Dispatch& d) {
+    constexpr size_t batch = 16;
+    GLuint ids[batch];
+    GLintptr rangeOffsets[batch];
+    GLsizeiptr rangeSizes[batch];
+    for (size_t start = 0; start < count; start += batch) {
+        size_t n = std::min(count - start, batch);
+        for (size_t i = 0; i < n; i++) {
+            ids[i] = buffers[start + i].m_id;
+            rangeOffsets[i] = offsets[start + i];
+            rangeSizes[i] = sizes[start + i];
+        }
+        d.glBindBuffersRange(static_cast<GLenum>(target), first + start, n, ids, rangeOffsets, rangeSizes);
+    }
+}
+
+OPENGL_HPP_FUNC void Buffer::bind(BufferTarget target, const Dispatch& d) {
+    d.glBindBuffer(static_cast<GLenum>(target), m_id);
+}
+
+OPENGL_HPP_FUNC void Buffer::bindBase(IndexedBufferTarget target, uint32_t index, const Dispatch& d) {
+    d.glBindBufferBase(static_cast<GLenum>(target), index, m_id);
+}
+
+OPENGL_HPP_FUNC void Buffer::bindRange(IndexedBufferTarget target, uint32_t index, size_t offset, size_t size, const Dispatch& d) {
+    d.glBindBufferRange(static_cast<GLenum>(target), index, m_id, offset, size);
+}
+
+OPENGL_HPP_FUNC void Buffer::storage(size_t size, const void *data, BufferStorage flags, const Dispatch& d) {
+    d.glNamedBufferStorage(m_id, size, data, static_cast<GLbitfield>(flags));
+}
+
+OPENGL_HPP_FUNC void Buffer::data(size_t size, const void *data, BufferUsage usage, const Dispatch& d) {
+    d.glNamedBufferData(m_id, size, data, static_cast<GLenum>(usage));
+}
+
+OPENGL_HPP_FUNC void Buffer::subData(size_t offset, size_t size, const void *data, const Dispatch& d) {
+    d.glNamedBufferSubData(m_id, offset, size, data);
+}
+
+OPENGL_HPP_FUNC void Buffer::getSubData(size_t offset, size_t size, void *data, const Dispatch& d) {
+    d.glGetNamedBufferSubData(m_id, offset, size, data);
+}
+
+OPENGL_HPP_FUNC void *Buffer::mapRange(size_t offset, size_t length, BufferMap access, const Dispatch& d) {
+    return d.glMapNamedBufferRange(m_id, offset, length, static_cast<GLbitfield>(access));
+}
+
+OPENGL_HPP_FUNC void Buffer::flushRange(size_t offset, size_t length, const Dispatch& d) {
+    d.glFlushMappedNamedBufferRange(m_id, offset, length);
+}
+
+OPENGL_HPP_FUNC void Buffer::unmap(const Dispatch& d) {
+    d.glUnmapNamedBuffer(m_id);
+}
+
+OPENGL_HPP_FUNC void Buffer::invalidateData(const Dispatch& d) {
+    d.glInvalidateBufferData(m_id);
+}
+
+OPENGL_HPP_FUNC void Buffer::invalidateSubData(size_t offset, size_t length, const Dispatch& d) {
+    d.glInvalidateBufferSubData(m_id, offset, length);
+}
+
+OPENGL_HPP_FUNC void Buffer::pageCommitment(size_t offset, size_t size, bool commit, const Dispatch& d) {
+    d.glNamedBufferPageCommitmentARB(m_id, offset, size, commit ? GL_TRUE : GL_FALSE);
+}
+
+OPENGL_HPP_FUNC BufferRangeTable::BufferRangeTable(IndexedBufferTarget target, uint32_t first) : m_target(target), m_first(first) {}
+
+OPENGL_HPP_FUNC void BufferRangeTable::set(uint32_t slot, Buffer& buffer, size_t offset, size_t size) {
+    if (slot >= m_buffers.size()) {
+        // the binding is cleared for slots left at buffer 0, but the per binding size check still runs
+        // and mesa rejects a size of 0 there with GL_INVALID_VALUE, so unset slots carry a size of 1
+        m_buffers.resize(slot + 1, 0);
+        m_offsets.resize(slot + 1, 0);
+        m_sizes.resize(slot + 1, 1);
+    }
+    m_buffers[slot] = buffer.m_id;
+    m_offsets[slot] = offset;
+    m_sizes[slot] = size;
+}
+
+OPENGL_HPP_FUNC void BufferRangeTable::clear() {
+    m_buffers.clear();
+    m_offsets.clear();
+    m_sizes.clear();
+}
+
+OPENGL_HPP_FUNC void BufferRangeTable::bind(const Dispatch& d) {
+    d.glBindBuffersRange(static_cast<GLenum>(m_target), m_first, m_buffers.size(), m_buffers.data(), m_offsets.data(), m_sizes.data());
+}
+
+OPENGL_HPP_FUNC VertexArray::VertexArray(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC VertexArray VertexArray::createVertexArray(const Dispatch& d) {
+    GLuint id;
+    d.glCreateVertexArrays(1, &id);
+    return {id};
+}
+
+OPENGL_HPP_FUNC UniqueVertexArray VertexArray::createVertexArrayUnique(const Dispatch& d) {
+    return UniqueVertexArray(createVertexArray(d));
+}
+
+OPENGL_HPP_FUNC std::vector<VertexArray> VertexArray::createVertexArrays(size_t count, const Dispatch& d) {
+    std::vector<GLuint> ids(count);
+    d.glCreateVertexArrays(count, ids.data());
+    std::vector<VertexArray> objects;
+    objects.reserve(count);
+    for (GLuint id : ids) {
+        objects.push_back(VertexArray(id));
+    }
+    return objects;
+}
+
+OPENGL_HPP_FUNC void VertexArray::deleteVertexArray(VertexArray& vertexArray, const Dispatch& d) {
+    d.glDeleteVertexArrays(1, &vertexArray.m_id);
+    vertexArray.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void VertexArray::deleteVertexArrays(size_t count, VertexArray *vertexArrays, const Dispatch& d) {
+    std::vector<GLuint> ids(count);
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = vertexArrays[i].m_id;
+        vertexArrays[i].m_id = 0;
+    }
+    d.glDeleteVertexArrays(count, ids.data());
+}
+
+OPENGL_HPP_FUNC void VertexArray::unbind(const Dispatch& d) {
+    d.glBindVertexArray(0);
+}
+
+OPENGL_HPP_FUNC void VertexArray::bind(const Dispatch& d) {
+    d.glBindVertexArray(m_id);
+}
+
+OPENGL_HPP_FUNC void VertexArray::enableAttrib(uint32_t index, const Dispatch& d) {
+    d.glEnableVertexArrayAttrib(m_id, index);
+}
+
+OPENGL_HPP_FUNC void VertexArray::disableAttrib(uint32_t index, const Dispatch& d) {
+    d.glDisableVertexArrayAttrib(m_id, index);
+}
+
+OPENGL_HPP_FUNC void VertexArray::attribBinding(uint32_t attribIndex, uint32_t bindingIndex, const Dispatch& d) {
+    d.glVertexArrayAttribBinding(m_id, attribIndex, bindingIndex);
+}
+
+OPENGL_HPP_FUNC void VertexArray::attribFormat(uint32_t attribIndex, int32_t size, Type type, bool normalised, uint32_t relativeOffset, const Dispatch& d) {
+    d.glVertexArrayAttribFormat(m_id, attribIndex, size, static_cast<GLenum>(type), normalised, relativeOffset);
+}
+
+OPENGL_HPP_FUNC void VertexArray::attribIFormat(uint32_t attribIndex, int32_t size, Type type, uint32_t relativeOffset, const Dispatch& d) {
+    d.glVertexArrayAttribIFormat(m_id, attribIndex, size, static_cast<GLenum>(type), relativeOffset);
+}
+
+OPENGL_HPP_FUNC void VertexArray::attribLFormat(uint32_t attribIndex, int32_t size, Type type, uint32_t relativeOffset, const Dispatch& d) {
+    d.glVertexArrayAttribLFormat(m_id, attribIndex, size, static_cast<GLenum>(type), relativeOffset);
+}
+
+OPENGL_HPP_FUNC void VertexArray::vertexBuffer(uint32_t bindingIndex, Buffer& buffer, size_t offset, size_t stride, const Dispatch& d) {
+    d.glVertexArrayVertexBuffer(m_id, bindingIndex, buffer.m_id, offset, stride);
+}
+
+OPENGL_HPP_FUNC void VertexArray::bindingDivisor(uint32_t bindingIndex, uint32_t divisor, const Dispatch& d) {
+    d.glVertexArrayBindingDivisor(m_id, bindingIndex, divisor);
+}
+
+OPENGL_HPP_FUNC void VertexArray::elementBuffer(Buffer& buffer, const Dispatch& d) {
+    d.glVertexArrayElementBuffer(m_id, buffer.m_id);
+}
+
+OPENGL_HPP_FUNC Shader::Shader(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC Shader Shader::createShader(ShaderType type, const Dispatch& d) {
+    return {d.glCreateShader(static_cast<GLenum>(type))};
+}
+
+OPENGL_HPP_FUNC UniqueShader Shader::createShaderUnique(ShaderType type, const Dispatch& d) {
+    return UniqueShader(createShader(type, d));
+}
+
+OPENGL_HPP_FUNC void Shader::deleteShader(Shader& shader, const Dispatch& d) {
+    d.glDeleteShader(shader.m_id);
+    shader.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void Shader::source(size_t count, const char *const string, const int *length, const Dispatch& d) {
+    d.glShaderSource(m_id, count, &string, length);
+}
+
+OPENGL_HPP_FUNC void Shader::compile(const Dispatch& d) {
+    d.glCompileShader(m_id);
+}
+
+OPENGL_HPP_FUNC void Shader::binary(ShaderBinaryFormat format, const void *binary, size_t length, const Dispatch& d) {
+    d.glShaderBinary(1, &m_id, static_cast<GLenum>(format), binary, length);
+}
+
+OPENGL_HPP_FUNC void Shader::specialize(const char *entryPoint, size_t count, const uint32_t *indices, const uint32_t *values, const Dispatch& d) {
+    d.glSpecializeShader(m_id, entryPoint, count, indices, values);
+}
+
+OPENGL_HPP_FUNC int Shader::getiv(ShaderIV pname, const Dispatch& d) {
+    int params;
+    d.glGetShaderiv(m_id, static_cast<GLenum>(pname), &params);
+    return params;
+}
+
+OPENGL_HPP_FUNC std::string Shader::getInfoLog(const Dispatch& d) {
+    int infoLength = getiv(ShaderIV::eInfoLogLength, d);
+    std::vector<char> infoBuff(infoLength);
+    d.glGetShaderInfoLog(m_id, infoLength, NULL, infoBuff.data());
+    return std::string(infoBuff.begin(), infoBuff.end());
+}
+
+OPENGL_HPP_FUNC Program::Program(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC Program Program::createProgram(const Dispatch& d) {
+    return {d.glCreateProgram()};
+}
+
+OPENGL_HPP_FUNC UniqueProgram Program::createProgramUnique(const Dispatch& d) {
+    return UniqueProgram(createProgram(d));
+}
+
+OPENGL_HPP_FUNC Program Program::createShaderProgram(ShaderType type, size_t count, const char *const string, const Dispatch& d) {
+    return {d.glCreateShaderProgramv(static_cast<GLenum>(type), count, &string)};
+}
+
+OPENGL_HPP_FUNC void Program::deleteProgram(Program& program, const Dispatch& d) {
+    d.glDeleteProgram(program.m_id);
+    program.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void Program::useNone(const Dispatch& d) {
+    d.glUseProgram(0);
+}
+
+OPENGL_HPP_FUNC void Program::use(const Dispatch& d) {
+    d.glUseProgram(m_id);
+}
+
+OPENGL_HPP_FUNC void Program::attachShader(Shader& shader, const Dispatch& d) {
+    d.glAttachShader(m_id, shader.m_id);
+} 
+
+OPENGL_HPP_FUNC void Program::parameter(ProgramParameter pname, int value, const Dispatch& d) {
+    d.glProgramParameteri(m_id, static_cast<GLenum>(pname), value);
+}
+
+OPENGL_HPP_FUNC void Program::link(const Dispatch& d) {
+    d.glLinkProgram(m_id);
+}
+
+OPENGL_HPP_FUNC int Program::getiv(ProgramIV pname, const Dispatch& d) {
+    int params;
+    d.glGetProgramiv(m_id, static_cast<GLenum>(pname), &params);
+    return params;
+}
+
+OPENGL_HPP_FUNC std::string Program::getInfoLog(const Dispatch& d) {
+    int infoLogLength = getiv(ProgramIV::eIngoLogLength, d);
+    std::vector<char> infoBuff(infoLogLength);
+    d.glGetProgramInfoLog(m_id, infoLogLength, NULL, infoBuff.data());
+    return std::string(infoBuff.begin(), infoBuff.end());
+}
+
+OPENGL_HPP_FUNC ProgramPipeline::ProgramPipeline(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC ProgramPipeline ProgramPipeline::createProgramPipeline(const Dispatch& d) {
+    GLuint id;
+    d.glCreateProgramPipelines(1, &id);
+    return {id};
+}
+
+OPENGL_HPP_FUNC UniqueProgramPipeline ProgramPipeline::createProgramPipelineUnique(const Dispatch& d) {
+    return UniqueProgramPipeline(createProgramPipeline(d));
+}
+
+OPENGL_HPP_FUNC void ProgramPipeline::deleteProgramPipeline(ProgramPipeline& programPipeline, const Dispatch& d) {
+    d.glDeleteProgramPipelines(1, &programPipeline.m_id);
+    programPipeline.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void ProgramPipeline::unbind(const Dispatch& d) {
+    d.glBindProgramPipeline(0);
+}
+
+OPENGL_HPP_FUNC void ProgramPipeline::bind(const Dispatch& d) {
+    d.glBindProgramPipeline(m_id);
+}
+
+OPENGL_HPP_FUNC void ProgramPipeline::useProgramStages(ProgramStage stages, Program& program, const Dispatch& d) {
+    d.glUseProgramStages(m_id, static_cast<GLbitfield>(stages), program.m_id);
+}
+
+OPENGL_HPP_FUNC void ProgramPipeline::activeShaderProgram(Program& program, const Dispatch& d) {
+    d.glActiveShaderProgram(m_id, program.m_id);
+}
+
+OPENGL_HPP_FUNC void ProgramPipeline::validate(const Dispatch& d) {
+    d.glValidateProgramPipeline(m_id);
+}
+
+OPENGL_HPP_FUNC int ProgramPipeline::getiv(ProgramPipelineIV pname, const Dispatch& d) {
+    int params;
+    d.glGetProgramPipelineiv(m_id, static_cast<GLenum>(pname), &params);
+    return params;
+}
+
+OPENGL_HPP_FUNC std::string ProgramPipeline::getInfoLog(const Dispatch& d) {
+    int infoLogLength = getiv(ProgramPipelineIV::eInfoLogLength, d);
+    std::vector<char> infoBuff(infoLogLength);
+    d.glGetProgramPipelineInfoLog(m_id, infoLogLength, NULL, infoBuff.data());
+    return std::string(infoBuff.begin(), infoBuff.end());
+}
+
+OPENGL_HPP_FUNC Renderbuffer::Renderbuffer(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC Renderbuffer Renderbuffer::createRenderbuffer(const Dispatch& d) {
+    GLuint id;
+    d.glCreateRenderbuffers(1, &id);
+    return {id};
+}
+
+OPENGL_HPP_FUNC UniqueRenderbuffer Renderbuffer::createRenderbufferUnique(const Dispatch& d) {
+    return UniqueRenderbuffer(createRenderbuffer(d));
+}
+
+OPENGL_HPP_FUNC void Renderbuffer::deleteRenderbuffer(Renderbuffer& renderbuffer, const Dispatch& d) {
+    d.glDeleteRenderbuffers(1, &renderbuffer.m_id);
+    renderbuffer.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void Renderbuffer::storage(InternalFormat internalFormat, uint32_t width, uint32_t height, const Dispatch& d) {
+    d.glNamedRenderbufferStorage(m_id, static_cast<GLenum>(internalFormat), width, height);
+}
+
+OPENGL_HPP_FUNC void Renderbuffer::storageMultisample(uint32_t samples, InternalFormat internalFormat, uint32_t width, uint32_t height, const Dispatch& d) {
+    d.glNamedRenderbufferStorageMultisample(m_id, samples, static_cast<GLenum>(internalFormat), width, height);
+}
+
+OPENGL_HPP_FUNC Texture::Texture(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC Texture Texture::createTexture(TextureType type, const Dispatch& d) {
+    GLuint id;
+    d.glCreateTextures(static_cast<GLenum>(type), 1, &id);
+    return {id};
+}
+
+OPENGL_HPP_FUNC UniqueTexture Texture::createTextureUnique(TextureType type, const Dispatch& d) {
+    return UniqueTexture(createTexture(type, d));
+}
+
+OPENGL_HPP_FUNC std::vector<Texture> Texture::createTextures(TextureType type, size_t count, const Dispatch& d) {
+    std::vector<GLuint> ids(count);
+    d.glCreateTextures(static_cast<GLenum>(type), count, ids.data());
+    std::vector<Texture> objects;
+    objects.reserve(count);
+    for (GLuint id : ids) {
+        objects.push_back(Texture(id));
+    }
+    return objects;
+}
+
+OPENGL_HPP_FUNC void Texture::deleteTexture(Texture& texture, const Dispatch& d) {
+    d.glDeleteTextures(1, &texture.m_id);
+    texture.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void Texture::deleteTextures(size_t count, Texture *textures, const Dispatch& d) {
+    std::vector<GLuint> ids(count);
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = textures[i].m_id;
+        textures[i].m_id = 0;
+    }
+    d.glDeleteTextures(count, ids.data());
+}
+
+OPENGL_HPP_FUNC void Texture::bindUnit(uint32_t unit, const Dispatch& d) {
+    d.glBindTextureUnit(unit, m_id);
+}
+
+OPENGL_HPP_FUNC void Texture::bindImage(uint32_t unit, int32_t level, bool layered, int32_t layer, ImageAccess access, InternalFormat format, const Dispatch& d) {
+    d.glBindImageTexture(unit, m_id, level, layered ? GL_TRUE : GL_FALSE, layer, static_cast<GLenum>(access), static_cast<GLenum>(format));
+}
+
+OPENGL_HPP_FUNC void Texture::parameter(TextureParameter pname, int value, const Dispatch& d) {
+    d.glTextureParameteri(m_id, static_cast<GLenum>(pname), value);
+}
+
+OPENGL_HPP_FUNC void Texture::storage1D(uint32_t levels, InternalFormat internalFormat, uint32_t width, const Dispatch& d) {
+    d.glTextureStorage1D(m_id, levels, static_cast<GLenum>(internalFormat), width);
+}
+
+OPENGL_HPP_FUNC void Texture::storage2D(uint32_t levels, InternalFormat internalFormat, uint32_t width, uint32_t height, const Dispatch& d) {
+    d.glTextureStorage2D(m_id, levels, static_cast<GLenum>(internalFormat), width, height);
+}
+
+OPENGL_HPP_FUNC void Texture::storage3D(uint32_t levels, InternalFormat internalFormat, uint32_t width, uint32_t height, uint32_t depth, const Dispatch& d) {
+    d.glTextureStorage3D(m_id, levels, static_cast<GLenum>(internalFormat), width, height, depth);
+}
+
+OPENGL_HPP_FUNC void Texture::subImage2D(int32_t level, int32_t x, int32_t y, uint32_t width, uint32_t height, Format format, Type type, const void *pixels, const Dispatch& d) {
+    d.glTextureSubImage2D(m_id, level, x, y, width, height, static_cast<GLenum>(format), static_cast<GLenum>(type), pixels);
+}
+
+OPENGL_HPP_FUNC void Texture::subImage3D(int32_t level, int32_t x, int32_t y, int32_t z, uint32_t width, uint32_t height, uint32_t depth, Format format, Type type, const void *pixels, const Dispatch& d) {
+    d.glTextureSubImage3D(m_id, level, x, y, z, width, height, depth, static_cast<GLenum>(format), static_cast<GLenum>(type), pixels);
+}
+
+OPENGL_HPP_FUNC void Texture::compressedSubImage2D(int32_t level, int32_t x, int32_t y, uint32_t width, uint32_t height, InternalFormat format, size_t imageSize, const void *data, const Dispatch& d) {
+    d.glCompressedTextureSubImage2D(m_id, level, x, y, width, height, static_cast<GLenum>(format), imageSize, data);
+}
+
+OPENGL_HPP_FUNC void Texture::compressedSubImage3D(int32_t level, int32_t x, int32_t y, int32_t z, uint32_t width, uint32_t height, uint32_t depth, InternalFormat format, size_t imageSize, const void *data, const Dispatch& d) {
+    d.glCompressedTextureSubImage3D(m_id, level, x, y, z, width, height, depth, static_cast<GLenum>(format), imageSize, data);
+}
+
+OPENGL_HPP_FUNC void Texture::clearImage(int32_t level, Format format, Type type, const void *data, const Dispatch& d) {
+    d.glClearTexImage(m_id, level, static_cast<GLenum>(format), static_cast<GLenum>(type), data);
+}
+
+OPENGL_HPP_FUNC void Texture::generateMipmap(const Dispatch& d) {
+    d.glGenerateTextureMipmap(m_id);
+}
+
+OPENGL_HPP_FUNC void Texture::pageCommitment(TextureType type, int32_t level, int32_t x, int32_t y, int32_t z, uint32_t width, uint32_t height, uint32_t depth, bool commit, const Dispatch& d) {
+    d.glBindTexture(static_cast<GLenum>(type), m_id);
+    d.glTexPageCommitmentARB(static_cast<GLenum>(type), level, x, y, z, width, height, depth, commit ? GL_TRUE : GL_FALSE);
+}
+
+OPENGL_HPP_FUNC Framebuffer::Framebuffer(GLuint id) : m_id(id) {}
+
+OPENGL_HPP_FUNC Framebuffer Framebuffer::createFramebuffer(const Dispatch& d) {
+    GLuint id;
+    d.glCreateFramebuffers(1, &id);
+    return {id};
+}
+
+OPENGL_HPP_FUNC UniqueFramebuffer Framebuffer::createFramebufferUnique(const Dispatch& d) {
+    return UniqueFramebuffer(createFramebuffer(d));
+}
+
+OPENGL_HPP_FUNC void Framebuffer::deleteFramebuffer(Framebuffer& framebuffer, const Dispatch& d) {
+    d.glDeleteFramebuffers(1, &framebuffer.m_id);
+    framebuffer.m_id = 0;
+}
+
+OPENGL_HPP_FUNC void Framebuffer::unbind(FramebufferTarget target, const Dispatch& d) {
+    d.glBindFramebuffer(static_cast<GLenum>(target), 0);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::blit(Framebuffer& readFramebuffer, Framebuffer& drawFramebuffer, int32_t srcX0, int32_t srcY0, int32_t srcX1, int32_t srcY1, int32_t dstX0, int32_t dstY0, int32_t dstX1, int32_t dstY1, ClearBufferBits mask, Filter filter, const Dispatch& d) {
+    d.glBlitNamedFramebuffer(readFramebuffer.m_id, drawFramebuffer.m_id, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, static_cast<GLbitfield>(mask), static_cast<GLenum>(filter));
+}
+
+OPENGL_HPP_FUNC void Framebuffer::bind(FramebufferTarget target, const Dispatch& d) {
+    d.glBindFramebuffer(static_cast<GLenum>(target), m_id);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::renderbuffer(FramebufferAttachment attachment, Renderbuffer& renderbuffer, const Dispatch& d) {
+    d.glNamedFramebufferRenderbuffer(m_id, static_cast<GLenum>(attachment), GL_RENDERBUFFER, renderbuffer.m_id);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::texture(FramebufferAttachment attachment, Texture& texture, int32_t level, const Dispatch& d) {
+    d.glNamedFramebufferTexture(m_id, static_cast<GLenum>(attachment), texture.m_id, level);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::clearColor(int32_t drawBuffer, const float *value, const Dispatch& d) {
+    d.glClearNamedFramebufferfv(m_id, GL_COLOR, drawBuffer, value);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::clearColor(int32_t drawBuffer, const uint32_t *value, const Dispatch& d) {
+    d.glClearNamedFramebufferuiv(m_id, GL_COLOR, drawBuffer, value);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::clearDepth(float depth, const Dispatch& d) {
+    d.glClearNamedFramebufferfv(m_id, GL_DEPTH, 0, &depth);
+}
+
+OPENGL_HPP_FUNC void Framebuffer::drawBuffers(size_t count, const FramebufferAttachment *attachments, const Dispatch& d) {
+    static_assert(sizeof(FramebufferAttachment) == sizeof(GLenum));
+    d.glNamedFramebufferDrawBuffers(m_id, count, reinterpret_cast<const GLenum *>(attachments));
+}
+
+OPENGL_HPP_FUNC void Framebuffer::readBuffer(FramebufferAttachment attachment, const Dispatch& d) {
+    d.glNamedFramebufferReadBuffer(m_id, static_cast<GLenum>(attachment));
+}
+
+OPENGL_HPP_FUNC FramebufferStatus Framebuffer::checkStatus(FramebufferTarget target, const Dispatch& d) {
+    return static_cast<FramebufferStatus>(d.glCheckNamedFramebufferStatus(m_id, static_cast<GLenum>(target)));
+}
+
+// function local so header only builds still share a single pointer per thread
+OPENGL_HPP_FUNC DeletionQueue *&currentDeletionQueue() {
+    static thread_local DeletionQueue *queue = nullptr;
+    return queue;
+}
+
+OPENGL_HPP_FUNC DeletionQueue::DeletionQueue(const Dispatch& d) : m_dispatch(&d) {}
+
+OPENGL_HPP_FUNC DeletionQueue::~DeletionQueue() {
+    flush();
+    deleteBatch(m_current, *m_dispatch);
+    if (currentDeletionQueue() == this) {
+        currentDeletionQueue() = nullptr;
+    }
+}
+
+OPENGL_HPP_FUNC void DeletionQueue::setCurrent(DeletionQueue *queue) {
+    currentDeletionQueue() = queue;
+}
+
+OPENGL_HPP_FUNC DeletionQueue *DeletionQueue::getCurrent() {
+    return currentDeletionQueue();
+}
+
+OPENGL_HPP_FUNC void DeletionQueue::defer(ObjectType type, GLuint id) {
+    if (currentDeletionQueue()) {
+        currentDeletionQueue()->push(type, id);
+        return;
+    }
+    Batch batch;
+    names(batch, type).push_back(id);
+    deleteBatch(batch, OPENGL_HPP_DEFAULT_DISPATCHER);
+}
+
+OPENGL_HPP_FUNC void DeletionQueue::push(ObjectType type, GLuint id) {
+    names(m_current, type).push_back(id);
+}
+
+OPENGL_HPP_FUNC void DeletionQueue::endFrame() {
+    bool empty = m_current.buffers.empty() && m_current.vertexArrays.empty() && m_current.shaders.empty() &&
+                 m_current.programs.empty() && m_current.programPipelines.empty() &&
+                 m_current.renderbuffers.empty() && m_current.textures.empty() && m_current.framebuffers.empty();
+    if (!empty) {
+        m_current.fence = m_dispatch->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_inFlight.push_back(std::move(m_current));
+        m_current = Batch{};
+    }
+    // fences signal in submission order, so stop at the first one that is still pending
+    while (!m_inFlight.empty()) {
+        GLenum status = m_dispatch->glClientWaitSync(m_inFlight.front().fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        deleteBatch(m_inFlight.front(), *m_dispatch);
+        m_inFlight.pop_front();
+    }
+}
+
+OPENGL_HPP_FUNC void DeletionQueue::flush() {
+    for (auto& batch : m_inFlight) {
+        m_dispatch->glClientWaitSync(batch.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        deleteBatch(batch, *m_dispatch);
+    }
+    m_inFlight.clear();
+}
+
+OPENGL_HPP_FUNC std::vector<GLuint>& DeletionQueue::names(Batch& batch, ObjectType type) {
+    switch (type) {
+        case ObjectType::eBuffer: return batch.buffers;
+        case ObjectType::eVertexArray: return batch.vertexArrays;
+        case ObjectType::eShader: return batch.shaders;
+        case ObjectType::eProgram: return batch.programs;
+        case ObjectType::eProgramPipeline: return batch.programPipelines;
+        case ObjectType::eRenderbuffer: return batch.renderbuffers;
+        case ObjectType::eTexture: return batch.textures;
+        case ObjectType::eFramebuffer: return batch.framebuffers;
+    }
+    return batch.buffers;
+}
+
+OPENGL_HPP_FUNC void DeletionQueue::deleteBatch(Batch& batch, const Dispatch& d) {
+    if (batch.fence) {
+        d.glDeleteSync(batch.fence);
+        batch.fence = nullptr;
+    }
+    if (!batch.buffers.empty()) {
+        d.glDeleteBuffers(batch.buffers.size(), batch.buffers.data());
+    }
+    if (!batch.vertexArrays.empty()) {
+        d.glDeleteVertexArrays(batch.vertexArrays.size(), batch.vertexArrays.data());
+    }
+    if (!batch.programPipelines.empty()) {
+        d.glDeleteProgramPipelines(batch.programPipelines.size(), batch.programPipelines.data());
+    }
+    if (!batch.renderbuffers.empty()) {
+        d.glDeleteRenderbuffers(batch.renderbuffers.size(), batch.renderbuffers.data());
+    }
+    if (!batch.textures.empty()) {
+        d.glDeleteTextures(batch.textures.size(), batch.textures.data());
+    }
+    if (!batch.framebuffers.empty()) {
+        d.glDeleteFramebuffers(batch.framebuffers.size(), batch.framebuffers.data());
+    }
+    // shaders and programs have no batched delete
+    for (GLuint id : batch.shaders) {
+        d.glDeleteShader(id);
+    }
+    for (GLuint id : batch.programs) {
+        d.glDeleteProgram(id);
+    }
+    batch.buffers.clear();
+    batch.vertexArrays.clear();
+    batch.shaders.clear();
+    batch.programs.clear();
+    batch.programPipelines.clear();
+    batch.renderbuffers.clear();
+    batch.textures.clear();
+    batch.framebuffers.clear();
+}
+
+OPENGL_HPP_FUNC void clearColor(float r, float g, float b, float a, const Dispatch& d) {
+    d.glClearColor(r, g, b, a);
+}
+
+OPENGL_HPP_FUNC void clear(ClearBufferBits mask, const Dispatch& d) {
+    d.glClear(static_cast<GLbitfield>(mask));
+}
+
+OPENGL_HPP_FUNC void viewport(int32_t x, int32_t y, uint32_t width, uint32_t height, const Dispatch& d) {
+    d.glViewport(x, y, width, height);
+}
+
+OPENGL_HPP_FUNC void readPixels(int32_t x, int32_t y, uint32_t width, uint32_t height, Format format, Type type, void *data, const Dispatch& d) {
+    d.glReadPixels(x, y, width, height, static_cast<GLenum>(format), static_cast<GLenum>(type), data);
+}
+
+OPENGL_HPP_FUNC void enable(Capabilities capability, const Dispatch& d) {
+    d.glEnable(static_cast<GLenum>(capability));
+}
+OPENGL_HPP_FUNC void disable(Capabilities capability, const Dispatch& d) {
+    d.glDisable(static_cast<GLenum>(capability));
+}
+
+OPENGL_HPP_FUNC void drawArrays(Primitive mode, int32_t first, size_t count, const Dispatch& d) {
+    d.glDrawArrays(static_cast<GLenum>(mode), first, count);
+}
+
+OPENGL_HPP_FUNC void drawElements(Primitive mode, size_t count, Type type, const void *indices, const Dispatch& d) {
+    d.glDrawElements(static_cast<GLenum>(mode), count, static_cast<GLenum>(type), indices);
+}
+
+OPENGL_HPP_FUNC void drawElements(Primitive mode, size_t count, IndexType type, const void *indices, const Dispatch& d) {
+    d.glDrawElements(static_cast<GLenum>(mode), count, static_cast<GLenum>(type), indices);
+}
+
+OPENGL_HPP_FUNC void drawArraysInstancedBaseInstance(Primitive mode, int32_t first, size_t count, size_t instanceCount, uint32_t baseInstance, const Dispatch& d) {
+    d.glDrawArraysInstancedBaseInstance(static_cast<GLenum>(mode), first, count, instanceCount, baseInstance);
+}
+
+OPENGL_HPP_FUNC void drawElementsInstancedBaseVertexBaseInstance(Primitive mode, size_t count, IndexType type, const void *indices, size_t instanceCount, int32_t baseVertex,
+                                                                 uint32_t baseInstance, const Dispatch& d) {
+    d.glDrawElementsInstancedBaseVertexBaseInstance(static_cast<GLenum>(mode), count, static_cast<GLenum>(type), indices, instanceCount, baseVertex, baseInstance);
+}
+
+OPENGL_HPP_FUNC void multiDrawElementsIndirect(Primitive mode, IndexType type, size_t offset, size_t drawCount, size_t stride, const Dispatch& d) {
+    d.glMultiDrawElementsIndirect(static_cast<GLenum>(mode), static_cast<GLenum>(type), reinterpret_cast<const void *>(offset), drawCount, stride);
+}
+
+OPENGL_HPP_FUNC void multiDrawElementsIndirectCount(Primitive mode, IndexType type, size_t offset, size_t countOffset, size_t maxDrawCount, size_t stride, const Dispatch& d) {
+    d.glMultiDrawElementsIndirectCount(static_cast<GLenum>(mode), static_cast<GLenum>(type), reinterpret_cast<const void *>(offset), countOffset, maxDrawCount, stride);
+}
+
+OPENGL_HPP_FUNC void dispatchCompute(uint32_t numGroupsX, uint32_t numGroupsY, uint32_t numGroupsZ, const Dispatch& d) {
+    d.glDispatchCompute(numGroupsX, numGroupsY, numGroupsZ);
+}
+
+OPENGL_HPP_FUNC void dispatchComputeIndirect(size_t offset, const Dispatch& d) {
+    d.glDispatchComputeIndirect(offset);
+}
+
+OPENGL_HPP_FUNC void memoryBarrier(MemoryBarrierBits barriers, const Dispatch& d) {
+    d.glMemoryBarrier(static_cast<GLbitfield>(barriers));
+}
+
+OPENGL_HPP_FUNC void memoryBarrierByRegion(MemoryBarrierBits barriers, const Dispatch& d) {
+    d.glMemoryBarrierByRegion(static_cast<GLbitfield>(barriers));
+}
+
+OPENGL_HPP_FUNC bool isExtensionSupported(const char *name, const Dispatch& d) {
+    GLint count = 0;
+    d.glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        if (std::strcmp(reinterpret_cast<const char *>(d.glGetStringi(GL_EXTENSIONS, i)), name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace gl
+
+#endif
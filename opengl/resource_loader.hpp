@@ -0,0 +1,74 @@
+#ifndef RESOURCE_LOADER_HPP
+#define RESOURCE_LOADER_HPP
+
+#include "opengl.hpp"
+#include "shader_reloader.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gl {
+
+// creates and fills objects on a background thread so streaming assets in never stalls the render thread
+// the background thread must have a context that shares objects with the render context
+// finished work is fenced on the loader context and published in update(), where the render context
+// waits on the fence server side (glWaitSync) instead of blocking the cpu
+class ResourceLoader {
+public:
+    // runs on the loader thread with its context current, returns what to run on the render thread once published
+    using Work = std::function<std::function<void()>(const Dispatch& d)>;
+
+    // makeContextCurrent is invoked once on the background thread before any work
+    // loaderDispatch is resolved against the loader context and used on the background thread,
+    // d against the render context, both must outlive the loader
+    ResourceLoader(std::function<void()> makeContextCurrent, const Dispatch& loaderDispatch, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    // work that has not started is dropped, finished work is still published
+    ~ResourceLoader();
+    ResourceLoader(const ResourceLoader&) = delete;
+    ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+    // never blocks, work runs in submission order
+    void enqueue(Work work);
+    // the buffer is created with immutable storage and handed to done on the render thread
+    void loadBuffer(std::vector<uint8_t> data, BufferStorage flags, std::function<void(Buffer)> done);
+    // sources are read and compiled on the loader thread, a failed build is reported to the error callback
+    void loadProgram(std::vector<ShaderSource> sources, std::function<void(Program)> done);
+
+    // call once per frame on the render thread, runs the done callbacks of everything finished so far
+    void update();
+    // blocks until every enqueued work has finished, then publishes it
+    void finish();
+    void setErrorCallback(std::function<void(const std::string&)> errorCallback);
+
+private:
+    struct Finished {
+        GLsync fence;
+        std::function<void()> publish;
+    };
+
+    void run(std::function<void()> makeContextCurrent);
+    void publish(std::deque<Finished>& finished);
+
+private:
+    const Dispatch *m_dispatch;
+    const Dispatch *m_loaderDispatch;
+    std::deque<Work> m_work;
+    std::deque<Finished> m_finished;
+    std::vector<std::string> m_errors;
+    std::function<void(const std::string&)> m_errorCallback;
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_idle;
+    bool m_busy;
+    bool m_stop;
+    std::thread m_thread;
+};
+
+} // namespace gl
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SHADER_RELOADER_HPP
+#define SHADER_RELOADER_HPP
+
+#include "opengl.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace gl {
+
+// reports files created or modified inside watched directories
+// uses inotify on linux and falls back to polling modification times elsewhere
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    void watchDirectory(const std::string& directory);
+    // blocks for at most timeoutMs, returns canonical paths of changed files
+    std::vector<std::string> poll(int timeoutMs);
+
+private:
+    std::mutex m_mutex;
+#ifdef __linux__
+    int m_fd;
+    std::unordered_map<int, std::string> m_directories;
+#else
+    std::vector<std::string> m_directories;
+    std::unordered_map<std::string, long long> m_writeTimes;
+#endif
+};
+
+struct ShaderSource {
+    ShaderType type;
+    std::string path;
+};
+
+// compiles and links every source into program
+// returns false and fills log if any stage fails to compile or the program fails to link
+bool buildProgram(const std::vector<ShaderSource>& sources, Program& program, std::string& log, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+
+// recompiles programs on a background thread when their sources change
+// the background thread must have a context that shares objects with the render context
+class ShaderReloader {
+public:
+    using Handle = size_t;
+
+    // makeContextCurrent is invoked once on the background thread before any compile
+    ShaderReloader(std::function<void()> makeContextCurrent, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~ShaderReloader();
+    ShaderReloader(const ShaderReloader&) = delete;
+    ShaderReloader& operator=(const ShaderReloader&) = delete;
+
+    // builds the first version on the calling thread and starts watching the source directories
+    Handle addProgram(const std::vector<ShaderSource>& sources);
+    Program getProgram(Handle handle);
+    // call once per frame on the render thread, swaps in programs whose compile has finished
+    // never blocks, a failed compile keeps the previous program alive
+    void update();
+    void setErrorCallback(std::function<void(const std::string&)> errorCallback);
+
+private:
+    struct Pending {
+        Handle handle;
+        Program program;
+        GLsync fence;
+    };
+
+    void run(std::function<void()> makeContextCurrent);
+
+private:
+    const Dispatch *m_dispatch;
+    FileWatcher m_watcher;
+    std::vector<Program> m_programs;
+    std::vector<std::vector<ShaderSource>> m_sources;
+    std::vector<Pending> m_pending;
+    std::vector<std::string> m_errors;
+    std::function<void(const std::string&)> m_errorCallback;
+    std::mutex m_mutex;
+    std::atomic<bool> m_stop;
+    std::thread m_thread;
+};
+
+} // namespace gl
+
+#endif
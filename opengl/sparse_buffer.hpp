@@ -0,0 +1,55 @@
+#ifndef SPARSE_BUFFER_HPP
+#define SPARSE_BUFFER_HPP
+
+#include "opengl.hpp"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace gl {
+
+// suballocator over a BufferStorage::eSparse buffer that reserves a large virtual range up front
+// pages are committed when the first allocation touches them and decommitted when the last one leaves,
+// so committed memory follows what is live instead of the peak
+// requires ARB_sparse_buffer
+class SparseBuffer {
+public:
+    // virtualSize is rounded up to the page size, flags are or'd with BufferStorage::eSparse
+    SparseBuffer(size_t virtualSize, BufferStorage flags = BufferStorage::eDynamic, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~SparseBuffer();
+    SparseBuffer(const SparseBuffer&) = delete;
+    SparseBuffer& operator=(const SparseBuffer&) = delete;
+
+    // returns the byte offset of the allocation, throws when the virtual range is exhausted or size or alignment is zero
+    // allocations of at least a page start on a page boundary so they touch as few pages as possible,
+    // smaller ones are packed and share pages
+    size_t allocate(size_t size, size_t alignment = 4);
+    void free(size_t offset);
+
+    Buffer getBuffer() const;
+    size_t getPageSize() const;
+    size_t getVirtualSize() const;
+    size_t getCommittedSize() const;
+
+private:
+    // adjusts the reference count of every page in [offset, offset + size), committing or decommitting
+    // runs of pages whose count leaves or reaches zero
+    void referencePages(size_t offset, size_t size, bool reference);
+    void commitRun(size_t firstPage, size_t pageCount, bool commit);
+
+private:
+    const Dispatch *m_dispatch;
+    Buffer m_buffer;
+    size_t m_pageSize;
+    size_t m_virtualSize;
+    // free blocks by offset, neighbours are merged on free
+    std::map<size_t, size_t> m_free;
+    std::unordered_map<size_t, size_t> m_allocations;
+    std::vector<uint32_t> m_pageReferences;
+    size_t m_committedPages;
+};
+
+} // namespace gl
+
+#endif
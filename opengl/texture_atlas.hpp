@@ -0,0 +1,112 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include "opengl.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace gl {
+
+// where an image landed in the atlas, uv covers the image without its padding
+struct AtlasRegion {
+    uint32_t layer;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    float u0;
+    float v0;
+    float u1;
+    float v1;
+};
+
+// packs images at runtime into the layers of one 2d array texture with a skyline bottom left packer,
+// so sprites and ui drawn from the atlas can share a single texture binding and draw call
+// add() copies into a persistently mapped staging ring, upload() then issues one glTextureSubImage3D per
+// new image from that ring, only rectangles added since the previous upload are touched
+// all calls must happen on the thread with the rendering context current
+class TextureAtlas {
+public:
+    struct CreateInfo {
+        uint32_t width = 2048;
+        uint32_t height = 2048;
+        // every layer is allocated up front, array textures cannot grow without a copy
+        uint32_t layers = 4;
+        InternalFormat internalFormat = InternalFormat::eR8G8B8A8;
+        Format format = Format::eRGBA;
+        Type type = Type::eUnsignedByte;
+        uint32_t texelSize = 4;
+        // edge texels repeated around each image so linear filtering does not bleed between neighbours
+        uint32_t padding = 1;
+        size_t stagingSize = 4 << 20;
+    };
+
+    explicit TextureAtlas(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~TextureAtlas();
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // pixels are tightly packed rows in the upload format, throws when no layer has room or a side is zero
+    // images too large for the staging ring are uploaded straight away
+    AtlasRegion add(uint32_t width, uint32_t height, const void *pixels);
+    // uploads every image added since the last call
+    void upload();
+    // forgets every placement, the texture keeps its contents until overwritten
+    void clear();
+    void bind(uint32_t unit);
+
+    Texture getTexture() const;
+    // fraction of the atlas area covered by placed images, padding included
+    float getOccupancy() const;
+
+private:
+    struct SkylineNode {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    struct PendingUpload {
+        uint32_t layer;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+        uint32_t height;
+        size_t offset;
+    };
+
+    struct StagingSegment {
+        GLsync fence;
+        size_t end;
+    };
+
+    // lowest y an image of width can rest at when its left edge is on node, false if it does not fit
+    bool fit(const std::vector<SkylineNode>& skyline, size_t node, uint32_t width, uint32_t height, uint32_t& y) const;
+    void place(std::vector<SkylineNode>& skyline, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    // copies the image with its padding extruded into dst, rows padded to 4 bytes
+    void extrude(uint8_t *dst, uint32_t width, uint32_t height, const uint8_t *pixels) const;
+    size_t rowPitch(uint32_t width) const;
+    // returns an offset into the staging ring, waiting on earlier uploads when the ring is full
+    size_t allocateStaging(size_t size);
+    void retireStaging(bool wait);
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    Texture m_texture;
+    std::vector<std::vector<SkylineNode>> m_skylines;
+    uint64_t m_usedArea = 0;
+
+    Buffer m_staging;
+    uint8_t *m_mapped;
+    size_t m_head = 0;
+    size_t m_tail = 0;
+    std::deque<StagingSegment> m_segments;
+    std::vector<PendingUpload> m_pending;
+};
+
+} // namespace gl
+
+#endif
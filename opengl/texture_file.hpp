@@ -0,0 +1,71 @@
+#ifndef TEXTURE_FILE_HPP
+#define TEXTURE_FILE_HPP
+
+#include "file.hpp"
+#include "opengl.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gl {
+
+struct CompressedBlockInfo {
+    uint32_t width;
+    uint32_t height;
+    uint32_t size;
+};
+
+// returns false for formats that are not block compressed
+bool getCompressedBlockInfo(InternalFormat format, CompressedBlockInfo& blockInfo);
+
+// block compressed texture read from a KTX2 or DDS file, the file stays mapped while this is alive
+// mip levels are uploaded straight from the mapping, the only copy is the driver's into a pixel unpack buffer
+// supports 2d, 2d array, cube map and cube map array textures in BCn, ETC2/EAC and ASTC formats,
+// supercompressed KTX2 files are rejected
+class TextureFile {
+public:
+    TextureFile() = delete;
+    // picks the container from the file's magic
+    static TextureFile loadFile(const char *filePath);
+    static void unloadFile(TextureFile& textureFile);
+
+    // creates the texture with immutable storage for every level and uploads all of them
+    Texture createTexture(const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER) const;
+
+    TextureType getType() const;
+    InternalFormat getInternalFormat() const;
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    uint32_t getLevelCount() const;
+    uint32_t getLayerCount() const;
+    uint32_t getFaceCount() const;
+
+private:
+    // blocks for layerCount consecutive layers (faces count as layers) of one mip level
+    struct Region {
+        uint32_t level;
+        uint32_t layer;
+        uint32_t layerCount;
+        size_t offset;
+        size_t size;
+    };
+
+    TextureFile(MappedFile file);
+    void parseKTX2();
+    void parseDDS();
+    size_t levelSize(uint32_t level) const;
+
+private:
+    MappedFile m_file;
+    InternalFormat m_internalFormat;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_levels;
+    uint32_t m_layers;
+    uint32_t m_faces;
+    std::vector<Region> m_regions;
+};
+
+} // namespace gl
+
+#endif
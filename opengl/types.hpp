@@ -1,104 +1,165 @@
 #ifndef TYPES_HPP
 #define TYPES_HPP
 
-#include <glad/glad.h>
+#include "glext.hpp"
 
 #include <iostream>
+#include <type_traits>
 
 namespace gl {
 
+// common operators for the bitmask types below, T is the derived flag type
+// flag types are a single GLbitfield, trivially copyable and usable in constant expressions,
+// so combining flags folds to an immediate while still rejecting flags of the wrong kind
 template <typename T>
 class BaseFlag {
 public:
-    T flags;
-    BaseFlag() = default;
-    BaseFlag(T flag) : flags(flag) {}
-    constexpr bool operator==(T other) {
+    GLbitfield flags;
+
+    constexpr BaseFlag() : flags(0) {}
+    constexpr explicit BaseFlag(GLbitfield flag) : flags(flag) {}
+
+    constexpr bool operator==(const T& other) const {
         return flags == other.flags;
     }
-    constexpr bool operator!=(T other) {
+    constexpr bool operator!=(const T& other) const {
         return flags != other.flags;
     }
-    constexpr explicit operator bool() {
+    constexpr explicit operator bool() const {
         return flags != 0;
     }
-    constexpr explicit operator T() {
+    constexpr explicit operator GLbitfield() const {
         return flags;
     }
-    constexpr BaseFlag operator|(T other) {
-        return {flags | other.flags};
+    constexpr T operator|(const T& other) const {
+        return T(flags | other.flags);
     }
-    constexpr BaseFlag operator&(T other) {
-        return {flags & other.flags};
+    constexpr T operator&(const T& other) const {
+        return T(flags & other.flags);
     }
-    constexpr BaseFlag operator^(T other) {
-        return {flags ^ other.flags};
+    constexpr T operator^(const T& other) const {
+        return T(flags ^ other.flags);
     }
-    constexpr BaseFlag operator~() {
-        return {~flags};
+    constexpr T operator~() const {
+        return T(~flags);
     }
-    constexpr BaseFlag& operator|=(T other) {
+    constexpr T& operator|=(const T& other) {
         flags |= other.flags;
-        return *this;
+        return static_cast<T&>(*this);
     }
-    constexpr BaseFlag& operator&=(T other) {
+    constexpr T& operator&=(const T& other) {
         flags &= other.flags;
-        return *this;
+        return static_cast<T&>(*this);
     }
-    constexpr BaseFlag& operator^=(T other) {
+    constexpr T& operator^=(const T& other) {
         flags ^= other.flags;
-        return *this;
+        return static_cast<T&>(*this);
     }
 };
 
-class BufferUsage : virtual public BaseFlag<GLenum> {
-public: 
-    BufferUsage() = default;
-    BufferUsage(GLbitfield flag) : BaseFlag(flag) {}
-    operator GLenum() {
-        return flags;
-    }
-    static constexpr GLenum eStreamDraw = GL_STREAM_DRAW;
-    static constexpr GLenum eStreamCopy = GL_STREAM_COPY;
-    static constexpr GLenum eStreamRead = GL_STREAM_READ;
+enum class BufferUsage : GLenum {
+    eStreamDraw = GL_STREAM_DRAW,
+    eStreamCopy = GL_STREAM_COPY,
+    eStreamRead = GL_STREAM_READ,
 
-    static constexpr GLenum eStaticDraw = GL_STATIC_DRAW;
-    static constexpr GLenum eStaticCopy = GL_STATIC_COPY;
-    static constexpr GLenum eStaticRead = GL_STATIC_READ;
+    eStaticDraw = GL_STATIC_DRAW,
+    eStaticCopy = GL_STATIC_COPY,
+    eStaticRead = GL_STATIC_READ,
 
-    static constexpr GLenum eDynamicDraw = GL_DYNAMIC_DRAW;
-    static constexpr GLenum eDynamicCopy = GL_DYNAMIC_COPY;
-    static constexpr GLenum eDynamicRead = GL_DYNAMIC_READ;
+    eDynamicDraw = GL_DYNAMIC_DRAW,
+    eDynamicCopy = GL_DYNAMIC_COPY,
+    eDynamicRead = GL_DYNAMIC_READ,
 };
 
-class BufferMap : virtual public BaseFlag<GLbitfield> {
+class BufferMap : public BaseFlag<BufferMap> {
 public:
-    BufferMap() = default;
-    BufferMap(GLbitfield flag) : BaseFlag(flag) {}
-    operator GLbitfield() {
-        return flags;
-    }
-    static constexpr GLbitfield eRead = GL_MAP_READ_BIT;
-    static constexpr GLbitfield eWrite = GL_MAP_WRITE_BIT;
-    static constexpr GLbitfield ePersistent = GL_MAP_PERSISTENT_BIT;
-    static constexpr GLbitfield eCoherent = GL_MAP_COHERENT_BIT;
-    static constexpr GLbitfield eInvalidateRange = GL_MAP_INVALIDATE_RANGE_BIT;
-    static constexpr GLbitfield eInvalidate = GL_MAP_INVALIDATE_BUFFER_BIT;
-    static constexpr GLbitfield eFlushExplicit = GL_MAP_FLUSH_EXPLICIT_BIT;
-    static constexpr GLbitfield eUnsynchronized = GL_MAP_UNSYNCHRONIZED_BIT;
-
+    using BaseFlag::BaseFlag;
+    static const BufferMap eRead;
+    static const BufferMap eWrite;
+    static const BufferMap ePersistent;
+    static const BufferMap eCoherent;
+    static const BufferMap eInvalidateRange;
+    static const BufferMap eInvalidate;
+    static const BufferMap eFlushExplicit;
+    static const BufferMap eUnsynchronized;
 };
 
-class BufferStorage : virtual public BufferMap {
+inline constexpr BufferMap BufferMap::eRead{GL_MAP_READ_BIT};
+inline constexpr BufferMap BufferMap::eWrite{GL_MAP_WRITE_BIT};
+inline constexpr BufferMap BufferMap::ePersistent{GL_MAP_PERSISTENT_BIT};
+inline constexpr BufferMap BufferMap::eCoherent{GL_MAP_COHERENT_BIT};
+inline constexpr BufferMap BufferMap::eInvalidateRange{GL_MAP_INVALIDATE_RANGE_BIT};
+inline constexpr BufferMap BufferMap::eInvalidate{GL_MAP_INVALIDATE_BUFFER_BIT};
+inline constexpr BufferMap BufferMap::eFlushExplicit{GL_MAP_FLUSH_EXPLICIT_BIT};
+inline constexpr BufferMap BufferMap::eUnsynchronized{GL_MAP_UNSYNCHRONIZED_BIT};
+
+static_assert(sizeof(BufferMap) == sizeof(GLbitfield));
+static_assert(std::is_trivially_copyable_v<BufferMap>);
+
+// only the map bits glNamedBufferStorage accepts are exposed
+class BufferStorage : public BaseFlag<BufferStorage> {
 public:
-    BufferStorage() = default;
-    BufferStorage(GLbitfield flag) : BaseFlag(flag) {}
-    operator GLbitfield() {
-        return flags;
-    }
-    static constexpr GLbitfield eDynamic = GL_DYNAMIC_STORAGE_BIT;
-    static constexpr GLbitfield eClient = GL_CLIENT_STORAGE_BIT;
-    static constexpr GLbitfield eNone = GL_NONE;
+    using BaseFlag::BaseFlag;
+    static const BufferStorage eNone;
+    static const BufferStorage eDynamic;
+    static const BufferStorage eClient;
+    static const BufferStorage eRead;
+    static const BufferStorage eWrite;
+    static const BufferStorage ePersistent;
+    static const BufferStorage eCoherent;
+    // ARB_sparse_buffer, size must be a multiple of GL_SPARSE_BUFFER_PAGE_SIZE_ARB and pages start uncommitted
+    static const BufferStorage eSparse;
+};
+
+inline constexpr BufferStorage BufferStorage::eNone{GL_NONE};
+inline constexpr BufferStorage BufferStorage::eDynamic{GL_DYNAMIC_STORAGE_BIT};
+inline constexpr BufferStorage BufferStorage::eClient{GL_CLIENT_STORAGE_BIT};
+inline constexpr BufferStorage BufferStorage::eRead{GL_MAP_READ_BIT};
+inline constexpr BufferStorage BufferStorage::eWrite{GL_MAP_WRITE_BIT};
+inline constexpr BufferStorage BufferStorage::ePersistent{GL_MAP_PERSISTENT_BIT};
+inline constexpr BufferStorage BufferStorage::eCoherent{GL_MAP_COHERENT_BIT};
+inline constexpr BufferStorage BufferStorage::eSparse{GL_SPARSE_STORAGE_BIT_ARB};
+
+static_assert(sizeof(BufferStorage) == sizeof(GLbitfield));
+static_assert(std::is_trivially_copyable_v<BufferStorage>);
+
+static_assert(static_cast<GLbitfield>(BufferStorage::eRead | BufferStorage::eWrite) == (GL_MAP_READ_BIT | GL_MAP_WRITE_BIT));
+
+enum class BufferTarget : GLenum {
+    eArray = GL_ARRAY_BUFFER,
+    eElementArray = GL_ELEMENT_ARRAY_BUFFER,
+    eCopyRead = GL_COPY_READ_BUFFER,
+    eCopyWrite = GL_COPY_WRITE_BUFFER,
+    eDispatchIndirect = GL_DISPATCH_INDIRECT_BUFFER,
+    eDrawIndirect = GL_DRAW_INDIRECT_BUFFER,
+    eParameter = GL_PARAMETER_BUFFER,
+    ePixelPack = GL_PIXEL_PACK_BUFFER,
+    ePixelUnpack = GL_PIXEL_UNPACK_BUFFER,
+    eQuery = GL_QUERY_BUFFER,
+    eTexture = GL_TEXTURE_BUFFER,
+    eUniform = GL_UNIFORM_BUFFER,
+    eShaderStorage = GL_SHADER_STORAGE_BUFFER,
+    eAtomicCounter = GL_ATOMIC_COUNTER_BUFFER,
+    eTransformFeedback = GL_TRANSFORM_FEEDBACK_BUFFER,
+};
+
+// targets that have an array of indexed binding points
+enum class IndexedBufferTarget : GLenum {
+    eUniform = GL_UNIFORM_BUFFER,
+    eShaderStorage = GL_SHADER_STORAGE_BUFFER,
+    eAtomicCounter = GL_ATOMIC_COUNTER_BUFFER,
+    eTransformFeedback = GL_TRANSFORM_FEEDBACK_BUFFER,
+};
+
+enum class ObjectType : GLenum {
+    eBuffer = GL_BUFFER,
+    eVertexArray = GL_VERTEX_ARRAY,
+    eShader = GL_SHADER,
+    eProgram = GL_PROGRAM,
+    eProgramPipeline = GL_PROGRAM_PIPELINE,
+    eFramebuffer = GL_FRAMEBUFFER,
+    eRenderbuffer = GL_RENDERBUFFER,
+    eTexture = GL_TEXTURE,
 };
 
 enum class Type : GLenum {
@@ -110,6 +171,19 @@ enum class Type : GLenum {
     eUnsignedInt = GL_UNSIGNED_INT,
     eFloat = GL_FLOAT,
     eDouble = GL_DOUBLE,
+    eHalfFloat = GL_HALF_FLOAT,
+    eFixed = GL_FIXED,
+    // packed types hold a whole 4 (or 3 for 10f_11f_11f) component attribute in 32 bits
+    eInt2101010Rev = GL_INT_2_10_10_10_REV,
+    eUnsignedInt2101010Rev = GL_UNSIGNED_INT_2_10_10_10_REV,
+    eUnsignedInt10F11F11FRev = GL_UNSIGNED_INT_10F_11F_11F_REV,
+};
+
+// the Type values drawElements accepts
+enum class IndexType : GLenum {
+    eUnsignedByte = GL_UNSIGNED_BYTE,
+    eUnsignedShort = GL_UNSIGNED_SHORT,
+    eUnsignedInt = GL_UNSIGNED_INT,
 };
 
 enum class ShaderType : GLenum{
@@ -127,6 +201,11 @@ enum class ShaderIV : GLenum {
     eCompileStatus = GL_COMPILE_STATUS,
     eInfoLogLength = GL_INFO_LOG_LENGTH,
     eShaderSourceLength = GL_SHADER_SOURCE_LENGTH,
+    eSPIRVBinary = GL_SPIR_V_BINARY,
+};
+
+enum class ShaderBinaryFormat : GLenum {
+    eSPIRV = GL_SHADER_BINARY_FORMAT_SPIR_V,
 };
 
 enum class ProgramIV : GLenum {
@@ -139,8 +218,49 @@ enum class ProgramIV : GLenum {
     eActiveAttributeMaxLength = GL_ACTIVE_ATTRIBUTE_MAX_LENGTH,
     eActiveUniforms = GL_ACTIVE_UNIFORMS,
     eActiveUniformMaxLength = GL_ACTIVE_UNIFORM_MAX_LENGTH,
+    eProgramSeparable = GL_PROGRAM_SEPARABLE,
+};
+
+enum class ProgramParameter : GLenum {
+    eBinaryRetrievableHint = GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+    eSeparable = GL_PROGRAM_SEPARABLE,
 };
 
+enum class ProgramPipelineIV : GLenum {
+    eActiveProgram = GL_ACTIVE_PROGRAM,
+    eValidateStatus = GL_VALIDATE_STATUS,
+    eInfoLogLength = GL_INFO_LOG_LENGTH,
+    eVertexShader = GL_VERTEX_SHADER,
+    eFragmentShader = GL_FRAGMENT_SHADER,
+    eGeometryShader = GL_GEOMETRY_SHADER,
+    eComputeShader = GL_COMPUTE_SHADER,
+    eTessControlShader = GL_TESS_CONTROL_SHADER,
+    eTessEvaluationShader = GL_TESS_EVALUATION_SHADER,
+};
+
+class ProgramStage : public BaseFlag<ProgramStage> {
+public:
+    using BaseFlag::BaseFlag;
+    static const ProgramStage eVertex;
+    static const ProgramStage eFragment;
+    static const ProgramStage eGeometry;
+    static const ProgramStage eCompute;
+    static const ProgramStage eTessControl;
+    static const ProgramStage eTessEvaluation;
+    static const ProgramStage eAll;
+};
+
+inline constexpr ProgramStage ProgramStage::eVertex{GL_VERTEX_SHADER_BIT};
+inline constexpr ProgramStage ProgramStage::eFragment{GL_FRAGMENT_SHADER_BIT};
+inline constexpr ProgramStage ProgramStage::eGeometry{GL_GEOMETRY_SHADER_BIT};
+inline constexpr ProgramStage ProgramStage::eCompute{GL_COMPUTE_SHADER_BIT};
+inline constexpr ProgramStage ProgramStage::eTessControl{GL_TESS_CONTROL_SHADER_BIT};
+inline constexpr ProgramStage ProgramStage::eTessEvaluation{GL_TESS_EVALUATION_SHADER_BIT};
+inline constexpr ProgramStage ProgramStage::eAll{GL_ALL_SHADER_BITS};
+
+static_assert(sizeof(ProgramStage) == sizeof(GLbitfield));
+static_assert(std::is_trivially_copyable_v<ProgramStage>);
+
 enum class Capabilities : GLenum {
     eColorLogicOP = GL_COLOR_LOGIC_OP,
     eColorTable = GL_COLOR_TABLE,
@@ -172,6 +292,49 @@ enum class Capabilities : GLenum {
     eVertexProgramPointSize = GL_VERTEX_PROGRAM_POINT_SIZE,
 };
 
+enum class FramebufferTarget : GLenum {
+    eFramebuffer = GL_FRAMEBUFFER,
+    eDraw = GL_DRAW_FRAMEBUFFER,
+    eRead = GL_READ_FRAMEBUFFER,
+};
+
+enum class FramebufferAttachment : GLenum {
+    eNone = GL_NONE,
+    eColor0 = GL_COLOR_ATTACHMENT0,
+    eColor1 = GL_COLOR_ATTACHMENT1,
+    eColor2 = GL_COLOR_ATTACHMENT2,
+    eColor3 = GL_COLOR_ATTACHMENT3,
+    eColor4 = GL_COLOR_ATTACHMENT4,
+    eColor5 = GL_COLOR_ATTACHMENT5,
+    eColor6 = GL_COLOR_ATTACHMENT6,
+    eColor7 = GL_COLOR_ATTACHMENT7,
+    eDepth = GL_DEPTH_ATTACHMENT,
+    eStencil = GL_STENCIL_ATTACHMENT,
+    eDepthStencil = GL_DEPTH_STENCIL_ATTACHMENT,
+};
+
+enum class FramebufferStatus : GLenum {
+    eComplete = GL_FRAMEBUFFER_COMPLETE,
+    eUndefined = GL_FRAMEBUFFER_UNDEFINED,
+    eIncompleteAttachment = GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT,
+    eIncompleteMissingAttachment = GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT,
+    eIncompleteDrawBuffer = GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER,
+    eIncompleteReadBuffer = GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER,
+    eUnsupported = GL_FRAMEBUFFER_UNSUPPORTED,
+    eIncompleteMultisample = GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE,
+    eIncompleteLayerTargets = GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS,
+};
+
+enum class Filter : GLenum {
+    eNearest = GL_NEAREST,
+    eLinear = GL_LINEAR,
+    // mipmap filters are only valid for TextureParameter::eMinFilter
+    eNearestMipmapNearest = GL_NEAREST_MIPMAP_NEAREST,
+    eLinearMipmapNearest = GL_LINEAR_MIPMAP_NEAREST,
+    eNearestMipmapLinear = GL_NEAREST_MIPMAP_LINEAR,
+    eLinearMipmapLinear = GL_LINEAR_MIPMAP_LINEAR,
+};
+
 enum class Primitive : GLenum {
     ePoints = GL_POINTS,
     eLineStrip = GL_LINE_STRIP,
@@ -187,69 +350,220 @@ enum class Primitive : GLenum {
     ePatches = GL_PATCHES,
 };
 
-class ClearBufferBits : public BaseFlag<GLbitfield> {
+class ClearBufferBits : public BaseFlag<ClearBufferBits> {
 public:
-    ClearBufferBits() = default;
-    ClearBufferBits(GLbitfield flag) : BaseFlag(flag) {}
-    operator GLbitfield() {
-        return flags;
-    }
-    constexpr static GLbitfield eColor = GL_COLOR_BUFFER_BIT;
-    constexpr static GLbitfield eDepth = GL_DEPTH_BUFFER_BIT;
-    constexpr static GLbitfield eStencil = GL_STENCIL_BUFFER_BIT;
+    using BaseFlag::BaseFlag;
+    static const ClearBufferBits eColor;
+    static const ClearBufferBits eDepth;
+    static const ClearBufferBits eStencil;
 };
 
-// enum class TextureType : GLint {
-//     e1D = GL_TEXTURE_1D,
-//     e2D = GL_TEXTURE_2D,
-//     e3D = GL_TEXTURE_3D,
-//     e1DArray = GL_TEXTURE_1D_ARRAY,
-//     e2DArray = GL_TEXTURE_2D_ARRAY,
-//     eCubeMap = GL_TEXTURE_CUBE_MAP,
-//     eCubeMapArray = GL_TEXTURE_CUBE_MAP_ARRAY,
-//     e2DMultiSample = GL_TEXTURE_2D_MULTISAMPLE,
-//     e2DMultiSampleArray = GL_TEXTURE_2D_MULTISAMPLE_ARRAY,
-// };
+inline constexpr ClearBufferBits ClearBufferBits::eColor{GL_COLOR_BUFFER_BIT};
+inline constexpr ClearBufferBits ClearBufferBits::eDepth{GL_DEPTH_BUFFER_BIT};
+inline constexpr ClearBufferBits ClearBufferBits::eStencil{GL_STENCIL_BUFFER_BIT};
 
-// enum class InternalFormat : GLint {
-//     eR8 = GL_R8,
-//     eR8snorm = GL_R8_SNORM,
-//     eR16 = GL_R16,
-//     eR16snorm = GL_R16_SNORM,
-
-//     eR8G8 = GL_RG8,
-//     eR8G8snorm = GL_RG8_SNORM,
-//     eR16G16 = GL_RG16,
-//     eR16G16snorm = GL_RG16_SNORM,
-
-//     eR8G8B8 = GL_RGB8,
-//     eR8G8B8snorm = GL_RGB8_SNORM,
-//     eR16G16B16 = GL_RGB16,
-//     eR16G16B16snorm = GL_RGB16_SNORM,
-
-//     eD32 = GL_DEPTH_COMPONENT32,
-//     eD32Float = GL_DEPTH_COMPONENT32F,
-//     eD24 = GL_DEPTH_COMPONENT24,
-//     eD16 = GL_DEPTH_COMPONENT16,
-//     eD32FS8 = GL_DEPTH32F_STENCIL8,
-//     eD24S8 = GL_DEPTH32F_STENCIL8,
-//     // todo: add all formats
-// };
+static_assert(sizeof(ClearBufferBits) == sizeof(GLbitfield));
+static_assert(std::is_trivially_copyable_v<ClearBufferBits>);
 
-// enum class SampleCount : uint8_t {
+class MemoryBarrierBits : public BaseFlag<MemoryBarrierBits> {
+public:
+    using BaseFlag::BaseFlag;
+    static const MemoryBarrierBits eVertexAttribArray;
+    static const MemoryBarrierBits eElementArray;
+    static const MemoryBarrierBits eUniform;
+    static const MemoryBarrierBits eTextureFetch;
+    static const MemoryBarrierBits eShaderImageAccess;
+    static const MemoryBarrierBits eCommand;
+    static const MemoryBarrierBits ePixelBuffer;
+    static const MemoryBarrierBits eTextureUpdate;
+    static const MemoryBarrierBits eBufferUpdate;
+    static const MemoryBarrierBits eClientMappedBuffer;
+    static const MemoryBarrierBits eFramebuffer;
+    static const MemoryBarrierBits eTransformFeedback;
+    static const MemoryBarrierBits eAtomicCounter;
+    static const MemoryBarrierBits eShaderStorage;
+    static const MemoryBarrierBits eQueryBuffer;
+    static const MemoryBarrierBits eAll;
+};
 
-// };
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eVertexAttribArray{GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eElementArray{GL_ELEMENT_ARRAY_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eUniform{GL_UNIFORM_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eTextureFetch{GL_TEXTURE_FETCH_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eShaderImageAccess{GL_SHADER_IMAGE_ACCESS_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eCommand{GL_COMMAND_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::ePixelBuffer{GL_PIXEL_BUFFER_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eTextureUpdate{GL_TEXTURE_UPDATE_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eBufferUpdate{GL_BUFFER_UPDATE_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eClientMappedBuffer{GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eFramebuffer{GL_FRAMEBUFFER_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eTransformFeedback{GL_TRANSFORM_FEEDBACK_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eAtomicCounter{GL_ATOMIC_COUNTER_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eShaderStorage{GL_SHADER_STORAGE_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eQueryBuffer{GL_QUERY_BUFFER_BARRIER_BIT};
+inline constexpr MemoryBarrierBits MemoryBarrierBits::eAll{GL_ALL_BARRIER_BITS};
+
+static_assert(sizeof(MemoryBarrierBits) == sizeof(GLbitfield));
+static_assert(std::is_trivially_copyable_v<MemoryBarrierBits>);
 
-// enum class Format : GLuint {
-//     eR = GL_RED,
-//     eRG = GL_RG,
-//     eRGB = GL_RGB,
-//     eRGBA = GL_RGBA,
-//     eBGRA = GL_BGRA,
+enum class TextureType : GLenum {
+    e1D = GL_TEXTURE_1D,
+    e2D = GL_TEXTURE_2D,
+    e3D = GL_TEXTURE_3D,
+    e1DArray = GL_TEXTURE_1D_ARRAY,
+    e2DArray = GL_TEXTURE_2D_ARRAY,
+    eCubeMap = GL_TEXTURE_CUBE_MAP,
+    eCubeMapArray = GL_TEXTURE_CUBE_MAP_ARRAY,
+    e2DMultiSample = GL_TEXTURE_2D_MULTISAMPLE,
+    e2DMultiSampleArray = GL_TEXTURE_2D_MULTISAMPLE_ARRAY,
+};
+
+enum class TextureParameter : GLenum {
+    eMinFilter = GL_TEXTURE_MIN_FILTER,
+    eMagFilter = GL_TEXTURE_MAG_FILTER,
+    eWrapS = GL_TEXTURE_WRAP_S,
+    eWrapT = GL_TEXTURE_WRAP_T,
+    eWrapR = GL_TEXTURE_WRAP_R,
+    eBaseLevel = GL_TEXTURE_BASE_LEVEL,
+    eMaxLevel = GL_TEXTURE_MAX_LEVEL,
+    // ARB_sparse_texture, both must be set before storage
+    eSparse = GL_TEXTURE_SPARSE_ARB,
+    eVirtualPageSizeIndex = GL_VIRTUAL_PAGE_SIZE_INDEX_ARB,
+};
+
+enum class Wrap : GLenum {
+    eRepeat = GL_REPEAT,
+    eMirroredRepeat = GL_MIRRORED_REPEAT,
+    eClampToEdge = GL_CLAMP_TO_EDGE,
+    eClampToBorder = GL_CLAMP_TO_BORDER,
+};
+
+enum class ImageAccess : GLenum {
+    eReadOnly = GL_READ_ONLY,
+    eWriteOnly = GL_WRITE_ONLY,
+    eReadWrite = GL_READ_WRITE,
+};
+
+enum class InternalFormat : GLenum {
+    eR8 = GL_R8,
+    eR8snorm = GL_R8_SNORM,
+    eR16 = GL_R16,
+    eR16snorm = GL_R16_SNORM,
+    eR16Float = GL_R16F,
+    eR32Float = GL_R32F,
+    eR32UInt = GL_R32UI,
+    eR8UInt = GL_R8UI,
+
+    eR8G8 = GL_RG8,
+    eR8G8snorm = GL_RG8_SNORM,
+    eR16G16 = GL_RG16,
+    eR16G16snorm = GL_RG16_SNORM,
+    eR16G16Float = GL_RG16F,
+    eR32G32Float = GL_RG32F,
+
+    eR8G8B8 = GL_RGB8,
+    eR8G8B8snorm = GL_RGB8_SNORM,
+    eR16G16B16 = GL_RGB16,
+    eR16G16B16snorm = GL_RGB16_SNORM,
+    eR11G11B10Float = GL_R11F_G11F_B10F,
+    eSR8G8B8 = GL_SRGB8,
+
+    eR8G8B8A8 = GL_RGBA8,
+    eR8G8B8A8snorm = GL_RGBA8_SNORM,
+    eR16G16B16A16 = GL_RGBA16,
+    eR16G16B16A16Float = GL_RGBA16F,
+    eR32G32B32A32Float = GL_RGBA32F,
+    eR10G10B10A2 = GL_RGB10_A2,
+    eSR8G8B8A8 = GL_SRGB8_ALPHA8,
+    eR8G8B8A8UInt = GL_RGBA8UI,
+    eR16G16B16A16UInt = GL_RGBA16UI,
+
+    eD32 = GL_DEPTH_COMPONENT32,
+    eD32Float = GL_DEPTH_COMPONENT32F,
+    eD24 = GL_DEPTH_COMPONENT24,
+    eD16 = GL_DEPTH_COMPONENT16,
+    eD32FS8 = GL_DEPTH32F_STENCIL8,
+    eD24S8 = GL_DEPTH24_STENCIL8,
+    eS8 = GL_STENCIL_INDEX8,
+
+    // block compressed, see getCompressedBlockInfo in texture_file.hpp
+    eBC1RGB = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+    eBC1RGBA = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+    eBC1SRGB = GL_COMPRESSED_SRGB_S3TC_DXT1_EXT,
+    eBC1SRGBA = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,
+    eBC2 = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,
+    eBC2SRGB = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT,
+    eBC3 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+    eBC3SRGB = GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,
+    eBC4 = GL_COMPRESSED_RED_RGTC1,
+    eBC4snorm = GL_COMPRESSED_SIGNED_RED_RGTC1,
+    eBC5 = GL_COMPRESSED_RG_RGTC2,
+    eBC5snorm = GL_COMPRESSED_SIGNED_RG_RGTC2,
+    eBC6HUFloat = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,
+    eBC6HSFloat = GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT,
+    eBC7 = GL_COMPRESSED_RGBA_BPTC_UNORM,
+    eBC7SRGB = GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,
+    eETC2RGB8 = GL_COMPRESSED_RGB8_ETC2,
+    eETC2SRGB8 = GL_COMPRESSED_SRGB8_ETC2,
+    eETC2RGB8A1 = GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,
+    eETC2SRGB8A1 = GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2,
+    eETC2RGBA8 = GL_COMPRESSED_RGBA8_ETC2_EAC,
+    eETC2SRGBA8 = GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,
+    eEACR11 = GL_COMPRESSED_R11_EAC,
+    eEACR11snorm = GL_COMPRESSED_SIGNED_R11_EAC,
+    eEACRG11 = GL_COMPRESSED_RG11_EAC,
+    eEACRG11snorm = GL_COMPRESSED_SIGNED_RG11_EAC,
+    eASTC4x4 = GL_COMPRESSED_RGBA_ASTC_4x4_KHR,
+    eASTC5x4 = GL_COMPRESSED_RGBA_ASTC_5x4_KHR,
+    eASTC5x5 = GL_COMPRESSED_RGBA_ASTC_5x5_KHR,
+    eASTC6x5 = GL_COMPRESSED_RGBA_ASTC_6x5_KHR,
+    eASTC6x6 = GL_COMPRESSED_RGBA_ASTC_6x6_KHR,
+    eASTC8x5 = GL_COMPRESSED_RGBA_ASTC_8x5_KHR,
+    eASTC8x6 = GL_COMPRESSED_RGBA_ASTC_8x6_KHR,
+    eASTC8x8 = GL_COMPRESSED_RGBA_ASTC_8x8_KHR,
+    eASTC10x5 = GL_COMPRESSED_RGBA_ASTC_10x5_KHR,
+    eASTC10x6 = GL_COMPRESSED_RGBA_ASTC_10x6_KHR,
+    eASTC10x8 = GL_COMPRESSED_RGBA_ASTC_10x8_KHR,
+    eASTC10x10 = GL_COMPRESSED_RGBA_ASTC_10x10_KHR,
+    eASTC12x10 = GL_COMPRESSED_RGBA_ASTC_12x10_KHR,
+    eASTC12x12 = GL_COMPRESSED_RGBA_ASTC_12x12_KHR,
+    eASTC4x4SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR,
+    eASTC5x4SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4_KHR,
+    eASTC5x5SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5_KHR,
+    eASTC6x5SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5_KHR,
+    eASTC6x6SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6_KHR,
+    eASTC8x5SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5_KHR,
+    eASTC8x6SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6_KHR,
+    eASTC8x8SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8_KHR,
+    eASTC10x5SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5_KHR,
+    eASTC10x6SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6_KHR,
+    eASTC10x8SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8_KHR,
+    eASTC10x10SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10_KHR,
+    eASTC12x10SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10_KHR,
+    eASTC12x12SRGB = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12_KHR,
+};
+
+// enum class SampleCount : uint8_t {
 
-//     //todo: add all formats  
 // };
 
+// pixel layout of client side data for uploads and readbacks
+enum class Format : GLenum {
+    eR = GL_RED,
+    eRG = GL_RG,
+    eRGB = GL_RGB,
+    eRGBA = GL_RGBA,
+    eBGR = GL_BGR,
+    eBGRA = GL_BGRA,
+    eRInteger = GL_RED_INTEGER,
+    eRGInteger = GL_RG_INTEGER,
+    eRGBInteger = GL_RGB_INTEGER,
+    eRGBAInteger = GL_RGBA_INTEGER,
+    eDepth = GL_DEPTH_COMPONENT,
+    eStencil = GL_STENCIL_INDEX,
+    eDepthStencil = GL_DEPTH_STENCIL,
+};
+
 // enum class Type : GLuint {
 //     eUByte = GL_UNSIGNED_BYTE,
 //     eSByte = GL_BYTE,
@@ -257,12 +571,6 @@ public:
 //     // todo: all all types
 // };
 
-// enum class Filter : GLuint {
-//     eNearest = GL_NEAREST,
-//     eLinear = GL_LINEAR,
-//     eNone = GL_NONE,
-// };
-
 } // namespace gl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef VERTEX_QUANTIZATION_HPP
+#define VERTEX_QUANTIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace gl {
+
+// cpu side packing of float vertex data into the compact attribute formats, each helper names the
+// VertexArray::attribFormat call that reads its output back
+// the array helpers use avx2 (picked at runtime on x86) or neon where available and fall back to scalar code
+
+// ieee half with round to nearest even, values past the half range become infinity
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+
+// count components, attribFormat(location, size, Type::eHalfFloat, false, offset)
+void packHalf(const float *src, uint16_t *dst, size_t count);
+// clamped to [-1, 1], attribFormat(location, size, Type::eShort, true, offset)
+void packSnorm16(const float *src, int16_t *dst, size_t count);
+// clamped to [0, 1], attribFormat(location, size, Type::eUnsignedShort, true, offset)
+void packUnorm16(const float *src, uint16_t *dst, size_t count);
+// clamped to [-1, 1], attribFormat(location, size, Type::eByte, true, offset)
+void packSnorm8(const float *src, int8_t *dst, size_t count);
+// clamped to [0, 1], attribFormat(location, size, Type::eUnsignedByte, true, offset)
+void packUnorm8(const float *src, uint8_t *dst, size_t count);
+
+// x, y and z take 10 bits each from the bottom up and w the top 2, w keeps only -1, 0 and 1
+// attribFormat(location, 4, Type::eInt2101010Rev, true, offset)
+uint32_t packSnorm2101010(float x, float y, float z, float w);
+// attribFormat(location, 4, Type::eUnsignedInt2101010Rev, true, offset)
+uint32_t packUnorm2101010(float x, float y, float z, float w);
+// count xyz triples packed with packSnorm2101010 and w = 0, a tangent's handedness can go through packSnorm2101010 instead
+void packNormals(const float *src, uint32_t *dst, size_t count);
+// unsigned floats with 6 bit mantissas for r and g and 5 for b, negatives clamp to 0, suits colors and hdr data
+// attribFormat(location, 3, Type::eUnsignedInt10F11F11FRev, false, offset)
+uint32_t packR11G11B10F(float r, float g, float b);
+
+// maps unorm16 positions back into their bounding box, position = offset + value * scale in the vertex shader
+struct PositionBounds {
+    float offset[3];
+    float scale[3];
+};
+
+// count xyz triples quantised to unorm16 over their own bounding box, dst receives count * 3 tightly packed values
+// attribFormat(location, 3, Type::eUnsignedShort, true, offset), with a 6 byte stride when bound on their own
+PositionBounds packPositions(const float *src, uint16_t *dst, size_t count);
+
+} // namespace gl
+
+#endif
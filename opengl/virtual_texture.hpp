@@ -0,0 +1,164 @@
+#ifndef VIRTUAL_TEXTURE_HPP
+#define VIRTUAL_TEXTURE_HPP
+
+#include "opengl.hpp"
+#include "worker_pool.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace gl {
+
+// page coordinates within a mip level of the virtual texture
+struct PageId {
+    uint32_t x;
+    uint32_t y;
+    uint32_t mip;
+};
+
+// streams the pages of a texture far larger than memory, keeping only what the camera sees resident
+// with ARB_sparse_texture (and a page size that is a multiple of the hardware page) pages are committed directly
+// into one sparse texture, otherwise they are packed into a physical cache texture and found through a page table
+// either way the page table holds, per page and mip, the finest mip currently resident for that region,
+// so sampling falls back to coarser data while finer pages stream in
+//
+// per frame:
+//   beginFeedback(), draw the scene with getFeedbackGLSL() writing vtFeedback(uv), endFeedback()
+//   update()
+//   bind() and draw the scene with getSampleGLSL() sampling through vtSample(uv)
+// all calls must happen on the thread with the rendering context current
+class VirtualTexture {
+public:
+    // fills pixels with a page of (pageSize + 2 * border)^2 texels in the upload format, runs on a worker thread
+    // returning false or fewer bytes leaves the page unloaded, it is asked for again while still visible
+    using PageLoader = std::function<bool(const PageId& page, std::vector<uint8_t>& pixels)>;
+
+    struct CreateInfo {
+        // virtual size in texels, multiples of pageSize
+        // the mip chain stops at the first level whose page count is odd, power of two page counts give a full chain
+        uint32_t width;
+        uint32_t height;
+        uint32_t pageSize = 128;
+        // texels repeated around each page so bilinear filtering in the cache does not bleed, ignored by sparse textures
+        uint32_t border = 0;
+        InternalFormat internalFormat = InternalFormat::eR8G8B8A8;
+        Format format = Format::eRGBA;
+        Type type = Type::eUnsignedByte;
+        uint32_t texelSize = 4;
+        PageLoader loader;
+        // pages that can be resident at once, the cache texture layout or the sparse commitment limit
+        uint32_t cachePagesX = 32;
+        uint32_t cachePagesY = 32;
+        // pages uploaded per update(), bounds the time streaming can take from a frame
+        uint32_t uploadsPerFrame = 8;
+        // the feedback target is the view size divided by this
+        uint32_t feedbackDivisor = 8;
+        size_t loaderThreads = 2;
+        bool preferSparse = true;
+        // uniform block binding of the parameters both glsl snippets read, VT_BINDING
+        uint32_t uniformBinding = 0;
+    };
+
+    explicit VirtualTexture(const CreateInfo& createInfo, const Dispatch& d = OPENGL_HPP_DEFAULT_DISPATCHER);
+    ~VirtualTexture();
+    VirtualTexture(const VirtualTexture&) = delete;
+    VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+    // binds the feedback framebuffer sized for the view and the parameter block, then clears it
+    void beginFeedback(uint32_t viewWidth, uint32_t viewHeight);
+    // queues an asynchronous readback of the feedback target, results are consumed by a later update()
+    void endFeedback();
+    // consumes finished feedback, schedules page loads and uploads at most uploadsPerFrame pages, never blocks
+    void update();
+    // binds the sampled texture, the page table and the parameter block used by the glsl snippets
+    void bind(uint32_t textureUnit, uint32_t pageTableUnit);
+
+    bool isSparse() const;
+    uint32_t getMipLevels() const;
+    size_t getResidentPageCount() const;
+
+    // glsl defining `uint vtFeedback(vec2 uv)`, write it to a r32ui output during the feedback pass
+    static const char *getFeedbackGLSL();
+    // glsl defining `vec4 vtSample(vec2 uv)`
+    // expects VT_TEXTURE_UNIT and VT_PAGE_TABLE_UNIT to be defined, plus VT_SPARSE when isSparse()
+    // both snippets expect VT_BINDING to match CreateInfo::uniformBinding
+    static const char *getSampleGLSL();
+
+    // loader reading pages stored back to back in a file, level by level from mip 0 and row by row within a level,
+    // each page laid out exactly as it is uploaded
+    static PageLoader createFileLoader(const std::string& filePath, const CreateInfo& createInfo);
+
+private:
+    struct ResidentPage {
+        uint32_t slot;
+        uint64_t lastUsed;
+        bool pinned;
+    };
+
+    struct LoadedPage {
+        PageId page;
+        std::vector<uint8_t> pixels;
+    };
+
+    struct FeedbackSlot {
+        Buffer buffer;
+        const uint32_t *mapped;
+        GLsync fence;
+    };
+
+    uint64_t pageKey(const PageId& page) const;
+    uint32_t pagesX(uint32_t mip) const;
+    uint32_t pagesY(uint32_t mip) const;
+    // bytes of one page as the loader returns it, border included
+    size_t pageBytes() const;
+    void createFeedbackTarget(uint32_t width, uint32_t height);
+    void destroyFeedbackTarget();
+    // marks the page and its ancestors as seen this frame and asks for any that are missing
+    void request(PageId page);
+    void schedule(const PageId& page);
+    // returns false when every cache slot holds a page seen this frame
+    bool upload(LoadedPage& loaded, bool pinned);
+    void evict(uint64_t key);
+    // rewrites the entries under each page loaded or evicted since the last call and uploads only those rects
+    void updatePageTable();
+
+private:
+    const Dispatch *m_dispatch;
+    CreateInfo m_info;
+    bool m_sparse;
+    uint32_t m_mipLevels;
+    uint64_t m_frame = 0;
+
+    Texture m_texture;
+    Texture m_pageTable;
+    Buffer m_uniforms;
+    std::vector<std::vector<uint32_t>> m_pageTableLevels;
+    std::vector<PageId> m_dirtyPages;
+
+    std::unordered_map<uint64_t, ResidentPage> m_resident;
+    std::vector<uint32_t> m_freeSlots;
+
+    Framebuffer m_feedbackFramebuffer;
+    Renderbuffer m_feedbackColor;
+    Renderbuffer m_feedbackDepth;
+    uint32_t m_feedbackWidth = 0;
+    uint32_t m_feedbackHeight = 0;
+    std::vector<FeedbackSlot> m_feedbackSlots;
+    size_t m_nextFeedbackSlot = 0;
+
+    // pages handed to the loader threads and not uploaded yet
+    std::unordered_set<uint64_t> m_loading;
+    std::vector<LoadedPage> m_loaded;
+    std::mutex m_loadedMutex;
+    size_t m_maxLoading;
+    WorkerPool m_loaders;
+};
+
+} // namespace gl
+
+#endif
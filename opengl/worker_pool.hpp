@@ -0,0 +1,50 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gl {
+
+// fixed set of cpu threads draining a bounded task queue
+// submit() blocks while the queue is full, which applies back pressure to the producer
+// an exception thrown by a task is caught on the worker and rethrown by the next waitIdle()
+class WorkerPool {
+public:
+    // threadCount 0 uses std::thread::hardware_concurrency
+    explicit WorkerPool(size_t threadCount = 0, size_t queueCapacity = 64);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> task);
+    // blocks until every submitted task has finished, then rethrows the first exception a task threw since the last call
+    void waitIdle();
+    // waitIdle() that drops task exceptions, for destructors
+    void drain() noexcept;
+    size_t getThreadCount() const;
+
+private:
+    void run();
+
+private:
+    size_t m_capacity;
+    size_t m_active = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_taskAvailable;
+    std::condition_variable m_spaceAvailable;
+    std::condition_variable m_idle;
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace gl
+
+#endif
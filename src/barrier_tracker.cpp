@@ -0,0 +1,85 @@
+#include "barrier_tracker.hpp"
+
+namespace gl {
+
+// buffer and texture names live in separate namespaces, keep them apart in the map
+static uint64_t bufferKey(GLuint id) {
+    return id;
+}
+
+static uint64_t imageKey(GLuint id) {
+    return (uint64_t(1) << 32) | id;
+}
+
+void BarrierTracker::write(Buffer& buffer) {
+    writeKey(bufferKey(buffer.m_id));
+}
+
+void BarrierTracker::write(Texture& texture) {
+    writeKey(imageKey(texture.m_id));
+}
+
+void BarrierTracker::writeImage(GLuint texture) {
+    writeKey(imageKey(texture));
+}
+
+void BarrierTracker::read(Buffer& buffer, MemoryBarrierBits access) {
+    readKey(bufferKey(buffer.m_id), static_cast<GLbitfield>(access));
+}
+
+void BarrierTracker::read(Texture& texture, MemoryBarrierBits access) {
+    readKey(imageKey(texture.m_id), static_cast<GLbitfield>(access));
+}
+
+void BarrierTracker::readImage(GLuint texture, MemoryBarrierBits access) {
+    readKey(imageKey(texture), static_cast<GLbitfield>(access));
+}
+
+void BarrierTracker::flush(const Dispatch& d) {
+    if (!m_pending) {
+        return;
+    }
+    d.glMemoryBarrier(m_pending);
+    // a barrier orders every write issued before it, not just the ones that asked for it
+    auto itr = m_written.begin();
+    while (itr != m_written.end()) {
+        itr->second |= m_pending;
+        if (itr->second == GL_ALL_BARRIER_BITS) {
+            itr = m_written.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    m_pending = 0;
+}
+
+void BarrierTracker::reset() {
+    m_written.clear();
+    m_pending = 0;
+}
+
+void BarrierTracker::forget(Buffer& buffer) {
+    m_written.erase(bufferKey(buffer.m_id));
+}
+
+void BarrierTracker::forget(Texture& texture) {
+    m_written.erase(imageKey(texture.m_id));
+}
+
+void BarrierTracker::forgetImage(GLuint texture) {
+    m_written.erase(imageKey(texture));
+}
+
+void BarrierTracker::writeKey(uint64_t key) {
+    m_written[key] = 0;
+}
+
+void BarrierTracker::readKey(uint64_t key, GLbitfield access) {
+    auto itr = m_written.find(key);
+    if (itr == m_written.end()) {
+        return;
+    }
+    m_pending |= access & ~itr->second;
+}
+
+} // namespace gl
@@ -0,0 +1,215 @@
+#include "cluster_culler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gl {
+
+static const char *cullSource = R"(
+layout(local_size_x = 64) in;
+
+struct Meshlet {
+    vec4 sphere;
+    vec4 cone;
+    // first index, index count
+    uvec4 range;
+};
+
+layout(std430, binding = FIRST_BINDING) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+// tightly packed DrawElementsIndirectCommands
+layout(std430, binding = FIRST_BINDING + 1) writeonly buffer Commands {
+    uint commands[];
+};
+layout(std430, binding = FIRST_BINDING + 2) buffer Count {
+    uint drawCount;
+};
+layout(std140, binding = UNIFORM_BINDING) uniform ClusterCullParams {
+    mat4 viewProjection;
+    mat4 model;
+    vec4 planes[6];
+    // xyz camera position, w the largest scale of model
+    vec4 camera;
+    // width, height, level count, occlusion culling enabled
+    vec4 pyramid;
+    // x meshlet count
+    uvec4 counts;
+};
+layout(binding = TEXTURE_UNIT) uniform sampler2D depthPyramid;
+
+void main() {
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= counts.x) {
+        return;
+    }
+    Meshlet meshlet = meshlets[id];
+    vec3 center = (model * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+    float radius = meshlet.sphere.w * camera.w;
+    for (int i = 0; i < 6; i++) {
+        if (dot(planes[i].xyz, center) + planes[i].w < -radius) {
+            return;
+        }
+    }
+    if (meshlet.cone.w < 1.0) {
+        vec3 axis = normalize(mat3(model) * meshlet.cone.xyz);
+        vec3 view = center - camera.xyz;
+        if (dot(view, axis) >= meshlet.cone.w * length(view) + radius) {
+            return;
+        }
+    }
+    if (pyramid.w != 0.0 && depthPyramidOccluded(depthPyramid, pyramid.xyz, viewProjection, center, radius)) {
+        return;
+    }
+    uint slot = atomicAdd(drawCount, 1u) * 5u;
+    commands[slot + 0u] = meshlet.range.y;
+    commands[slot + 1u] = 1u;
+    commands[slot + 2u] = meshlet.range.x;
+    commands[slot + 3u] = 0u;
+    commands[slot + 4u] = id;
+}
+)";
+
+// matches the Meshlet struct above
+struct GpuMeshlet {
+    float sphere[4];
+    float cone[4];
+    uint32_t range[4];
+};
+
+// matches the ClusterCullParams block above
+struct CullParams {
+    float viewProjection[16];
+    float model[16];
+    float planes[6][4];
+    float camera[4];
+    float pyramid[4];
+    uint32_t counts[4];
+};
+
+static Program createCullProgram(const ClusterCuller::CreateInfo& info, const Dispatch& d) {
+    std::string source = "#version 450\n";
+    source += "#define FIRST_BINDING " + std::to_string(info.firstBinding) + "\n";
+    source += "#define UNIFORM_BINDING " + std::to_string(info.uniformBinding) + "\n";
+    source += "#define TEXTURE_UNIT " + std::to_string(info.textureUnit) + "\n";
+    source += DepthPyramid::getOcclusionGLSL();
+    source += cullSource;
+    Program program = Program::createShaderProgram(ShaderType::eCompute, 1, source.c_str(), d);
+    if (!program.getiv(ProgramIV::eLinkStatus, d)) {
+        std::string log = program.getInfoLog(d);
+        Program::deleteProgram(program, d);
+        throw std::runtime_error("Failed to build the ClusterCuller shader!\n" + log);
+    }
+    return program;
+}
+
+static const MeshletMesh& checkedMesh(const ClusterCuller::CreateInfo& info) {
+    if (!info.mesh || info.mesh->meshlets.empty()) {
+        throw std::runtime_error("Failed to create ClusterCuller, the mesh has no meshlets!");
+    }
+    return *info.mesh;
+}
+
+ClusterCuller::ClusterCuller(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(createInfo),
+    m_meshletCount(checkedMesh(createInfo).meshlets.size()),
+    m_indexBuffer(IndexBuffer::createIndexBuffer(createInfo.mesh->indices.data(), createInfo.mesh->indices.size(), createInfo.vertexCount,
+                                                 BufferStorage::eNone, IndexType::eUnsignedByte, d)),
+    m_meshlets(Buffer::createBuffer(d)),
+    m_commands(Buffer::createBuffer(d)),
+    m_count(Buffer::createBuffer(d)),
+    m_uniforms(Buffer::createBuffer(d)),
+    m_program(createCullProgram(createInfo, d)) {
+    const MeshletMesh& mesh = *m_info.mesh;
+    std::vector<GpuMeshlet> meshlets(m_meshletCount);
+    for (size_t i = 0; i < m_meshletCount; i++) {
+        const MeshletBounds& bounds = mesh.bounds[i];
+        meshlets[i] = {
+            {bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius},
+            {bounds.coneAxis[0], bounds.coneAxis[1], bounds.coneAxis[2], bounds.coneCutoff},
+            {mesh.meshlets[i].firstIndex, mesh.meshlets[i].indexCount, 0, 0},
+        };
+    }
+    m_meshlets.storage(meshlets.size() * sizeof(GpuMeshlet), meshlets.data(), BufferStorage::eNone, d);
+    m_commands.storage(m_meshletCount * sizeof(DrawElementsIndirectCommand), nullptr, BufferStorage::eNone, d);
+    uint32_t zero = 0;
+    m_count.storage(sizeof(zero), &zero, BufferStorage::eDynamic, d);
+    m_uniforms.storage(sizeof(CullParams), nullptr, BufferStorage::eDynamic, d);
+    // the mesh is only read here, the caller may free it
+    m_info.mesh = nullptr;
+}
+
+ClusterCuller::~ClusterCuller() {
+    Program::deleteProgram(m_program, *m_dispatch);
+    Buffer::deleteBuffer(m_uniforms, *m_dispatch);
+    Buffer::deleteBuffer(m_count, *m_dispatch);
+    Buffer::deleteBuffer(m_commands, *m_dispatch);
+    Buffer::deleteBuffer(m_meshlets, *m_dispatch);
+    IndexBuffer::deleteIndexBuffer(m_indexBuffer, *m_dispatch);
+}
+
+void ClusterCuller::cull(const View& view) {
+    const Dispatch& d = *m_dispatch;
+    CullParams params = {};
+    std::copy(view.viewProjection, view.viewProjection + 16, params.viewProjection);
+    std::copy(view.model, view.model + 16, params.model);
+    extractFrustumPlanes(view.viewProjection, params.planes);
+    float maxScale = 0.0f;
+    for (int column = 0; column < 3; column++) {
+        const float *axis = view.model + column * 4;
+        maxScale = std::max(maxScale, std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]));
+    }
+    params.camera[0] = view.cameraPosition[0];
+    params.camera[1] = view.cameraPosition[1];
+    params.camera[2] = view.cameraPosition[2];
+    params.camera[3] = maxScale;
+    if (view.pyramid) {
+        params.pyramid[0] = float(view.pyramid->getWidth());
+        params.pyramid[1] = float(view.pyramid->getHeight());
+        params.pyramid[2] = float(view.pyramid->getLevelCount());
+        params.pyramid[3] = 1.0f;
+        view.pyramid->bindUnit(m_info.textureUnit);
+    }
+    params.counts[0] = uint32_t(m_meshletCount);
+    m_uniforms.subData(0, sizeof(params), &params, d);
+    uint32_t zero = 0;
+    m_count.subData(0, sizeof(zero), &zero, d);
+
+    m_meshlets.bindBase(IndexedBufferTarget::eShaderStorage, m_info.firstBinding, d);
+    m_commands.bindBase(IndexedBufferTarget::eShaderStorage, m_info.firstBinding + 1, d);
+    m_count.bindBase(IndexedBufferTarget::eShaderStorage, m_info.firstBinding + 2, d);
+    m_uniforms.bindBase(IndexedBufferTarget::eUniform, m_info.uniformBinding, d);
+    m_program.use(d);
+    dispatchCompute(uint32_t((m_meshletCount + 63) / 64), 1, 1, d);
+    memoryBarrier(MemoryBarrierBits::eCommand | MemoryBarrierBits::eShaderStorage, d);
+    Program::useNone(d);
+}
+
+void ClusterCuller::draw(Primitive mode) {
+    const Dispatch& d = *m_dispatch;
+    m_commands.bind(BufferTarget::eDrawIndirect, d);
+    m_count.bind(BufferTarget::eParameter, d);
+    multiDrawElementsIndirectCount(mode, m_indexBuffer.getType(), 0, 0, m_meshletCount, sizeof(DrawElementsIndirectCommand), d);
+}
+
+const IndexBuffer& ClusterCuller::getIndexBuffer() const {
+    return m_indexBuffer;
+}
+
+Buffer ClusterCuller::getCommandBuffer() const {
+    return m_commands;
+}
+
+Buffer ClusterCuller::getCountBuffer() const {
+    return m_count;
+}
+
+size_t ClusterCuller::getMeshletCount() const {
+    return m_meshletCount;
+}
+
+} // namespace gl
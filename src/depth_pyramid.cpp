@@ -0,0 +1,182 @@
+#include "depth_pyramid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace gl {
+
+static const char *copySource = R"(
+layout(local_size_x = 8, local_size_y = 8) in;
+layout(binding = TEXTURE_UNIT) uniform sampler2D depthTexture;
+layout(binding = IMAGE_UNIT + 1, r32f) uniform writeonly image2D dst;
+
+void main() {
+    ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+    if (any(greaterThanEqual(p, imageSize(dst)))) {
+        return;
+    }
+    imageStore(dst, p, vec4(texelFetch(depthTexture, p, 0).r));
+}
+)";
+
+static const char *reduceSource = R"(
+layout(local_size_x = 8, local_size_y = 8) in;
+layout(binding = IMAGE_UNIT, r32f) uniform readonly image2D src;
+layout(binding = IMAGE_UNIT + 1, r32f) uniform writeonly image2D dst;
+
+void main() {
+    ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(dst);
+    if (any(greaterThanEqual(p, size))) {
+        return;
+    }
+    ivec2 srcSize = imageSize(src);
+    ivec2 first = p * 2;
+    // the last texel of a row or column also takes the leftover one of an odd source
+    ivec2 last = min(first + 1 + ivec2(equal(p, size - 1)) * (srcSize & 1), srcSize - 1);
+    float depth = 0.0;
+    for (int y = first.y; y <= last.y; y++) {
+        for (int x = first.x; x <= last.x; x++) {
+            depth = max(depth, imageLoad(src, ivec2(x, y)).r);
+        }
+    }
+    imageStore(dst, p, vec4(depth));
+}
+)";
+
+static Program createComputeProgram(const DepthPyramid::CreateInfo& info, const char *body, const Dispatch& d) {
+    std::string source = "#version 450\n";
+    source += "#define TEXTURE_UNIT " + std::to_string(info.textureUnit) + "\n";
+    source += "#define IMAGE_UNIT " + std::to_string(info.imageUnit) + "\n";
+    source += body;
+    Program program = Program::createShaderProgram(ShaderType::eCompute, 1, source.c_str(), d);
+    if (!program.getiv(ProgramIV::eLinkStatus, d)) {
+        std::string log = program.getInfoLog(d);
+        Program::deleteProgram(program, d);
+        throw std::runtime_error("Failed to build the DepthPyramid shaders!\n" + log);
+    }
+    return program;
+}
+
+static uint32_t groupCount(uint32_t size) {
+    return (size + 7) / 8;
+}
+
+DepthPyramid::DepthPyramid(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(createInfo),
+    m_levels(1),
+    m_texture(Texture::createTexture(TextureType::e2D, d)),
+    m_copy(createComputeProgram(createInfo, copySource, d)),
+    m_reduce(createComputeProgram(createInfo, reduceSource, d)) {
+    if (m_info.width == 0 || m_info.height == 0) {
+        throw std::runtime_error("Failed to create DepthPyramid, the size must not be zero!");
+    }
+    while (std::max(m_info.width, m_info.height) >> m_levels) {
+        m_levels++;
+    }
+    m_texture.storage2D(m_levels, InternalFormat::eR32Float, m_info.width, m_info.height, d);
+    m_texture.parameter(TextureParameter::eMinFilter, static_cast<int>(Filter::eNearestMipmapNearest), d);
+    m_texture.parameter(TextureParameter::eMagFilter, static_cast<int>(Filter::eNearest), d);
+    m_texture.parameter(TextureParameter::eWrapS, static_cast<int>(Wrap::eClampToEdge), d);
+    m_texture.parameter(TextureParameter::eWrapT, static_cast<int>(Wrap::eClampToEdge), d);
+}
+
+DepthPyramid::~DepthPyramid() {
+    Program::deleteProgram(m_reduce, *m_dispatch);
+    Program::deleteProgram(m_copy, *m_dispatch);
+    Texture::deleteTexture(m_texture, *m_dispatch);
+}
+
+void DepthPyramid::build(Texture& depth) {
+    const Dispatch& d = *m_dispatch;
+    depth.bindUnit(m_info.textureUnit, d);
+    m_texture.bindImage(m_info.imageUnit + 1, 0, false, 0, ImageAccess::eWriteOnly, InternalFormat::eR32Float, d);
+    m_copy.use(d);
+    dispatchCompute(groupCount(m_info.width), groupCount(m_info.height), 1, d);
+
+    m_reduce.use(d);
+    for (uint32_t level = 1; level < m_levels; level++) {
+        memoryBarrier(MemoryBarrierBits::eShaderImageAccess, d);
+        m_texture.bindImage(m_info.imageUnit, level - 1, false, 0, ImageAccess::eReadOnly, InternalFormat::eR32Float, d);
+        m_texture.bindImage(m_info.imageUnit + 1, level, false, 0, ImageAccess::eWriteOnly, InternalFormat::eR32Float, d);
+        dispatchCompute(groupCount(std::max(m_info.width >> level, 1u)), groupCount(std::max(m_info.height >> level, 1u)), 1, d);
+    }
+    memoryBarrier(MemoryBarrierBits::eTextureFetch, d);
+    Program::useNone(d);
+}
+
+void DepthPyramid::bindUnit(uint32_t unit) {
+    m_texture.bindUnit(unit, *m_dispatch);
+}
+
+Texture DepthPyramid::getTexture() const {
+    return m_texture;
+}
+
+uint32_t DepthPyramid::getWidth() const {
+    return m_info.width;
+}
+
+uint32_t DepthPyramid::getHeight() const {
+    return m_info.height;
+}
+
+uint32_t DepthPyramid::getLevelCount() const {
+    return m_levels;
+}
+
+const char *DepthPyramid::getOcclusionGLSL() {
+    return R"(
+bool depthPyramidOccluded(sampler2D pyramid, vec3 size, mat4 viewProjection, vec3 center, float radius) {
+    vec2 lo = vec2(1.0);
+    vec2 hi = vec2(-1.0);
+    float nearest = 1.0;
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = center + radius * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = viewProjection * vec4(corner, 1.0);
+        if (clip.w <= 0.0) {
+            return false;
+        }
+        vec3 ndc = clip.xyz / clip.w;
+        lo = min(lo, ndc.xy);
+        hi = max(hi, ndc.xy);
+        nearest = min(nearest, ndc.z);
+    }
+    lo = clamp(lo * 0.5 + 0.5, 0.0, 1.0) * size.xy;
+    hi = clamp(hi * 0.5 + 0.5, 0.0, 1.0) * size.xy;
+    // the level where the rect spans at most two texels per axis
+    float extent = max(hi.x - lo.x, hi.y - lo.y);
+    int level = clamp(int(ceil(log2(max(extent, 1.0)))), 0, int(size.z) - 1);
+    // sizes follow from the level 0 size, some drivers get textureSize wrong for a lod that varies across invocations
+    ivec2 levelSize = max(ivec2(size.xy) >> level, ivec2(1));
+    ivec2 a = min(ivec2(lo) >> level, levelSize - 1);
+    ivec2 b = min(ivec2(hi) >> level, levelSize - 1);
+    float farthest = max(max(texelFetch(pyramid, a, level).r, texelFetch(pyramid, ivec2(b.x, a.y), level).r),
+                         max(texelFetch(pyramid, ivec2(a.x, b.y), level).r, texelFetch(pyramid, b, level).r));
+    return nearest * 0.5 + 0.5 > farthest;
+}
+)";
+}
+
+void extractFrustumPlanes(const float *viewProjection, float planes[6][4]) {
+    // gribb and hartmann, the planes are row 3 plus or minus rows 0, 1 and 2
+    const float *m = viewProjection;
+    for (int plane = 0; plane < 6; plane++) {
+        int row = plane / 2;
+        float sign = plane % 2 ? -1.0f : 1.0f;
+        for (int c = 0; c < 4; c++) {
+            planes[plane][c] = m[c * 4 + 3] + sign * m[c * 4 + row];
+        }
+        float length = std::sqrt(planes[plane][0] * planes[plane][0] + planes[plane][1] * planes[plane][1] + planes[plane][2] * planes[plane][2]);
+        if (length > 0.0f) {
+            for (int c = 0; c < 4; c++) {
+                planes[plane][c] /= length;
+            }
+        }
+    }
+}
+
+} // namespace gl
@@ -0,0 +1,83 @@
+#include "file.hpp"
+
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OPENGL_HPP_MMAP
+#else
+#include <fstream>
+#endif
+
+namespace gl {
+
+MappedFile::MappedFile(void *data, size_t size) : m_data(data), m_size(size) {}
+
+#ifdef OPENGL_HPP_MMAP
+
+MappedFile MappedFile::mapFile(const char *filePath) {
+    int fd = open(filePath, O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Failed to open file!");
+    }
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        throw std::runtime_error("Failed to stat file!");
+    }
+    size_t size = st.st_size;
+    if (size == 0) {
+        close(fd);
+        return {nullptr, 0};
+    }
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping keeps the file alive, the descriptor is no longer needed
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("Failed to map file!");
+    }
+    return {data, size};
+}
+
+void MappedFile::unmapFile(MappedFile& mappedFile) {
+    if (mappedFile.m_data) {
+        munmap(mappedFile.m_data, mappedFile.m_size);
+    }
+    mappedFile.m_data = nullptr;
+    mappedFile.m_size = 0;
+}
+
+#else
+
+MappedFile MappedFile::mapFile(const char *filePath) {
+    std::ifstream ifs(filePath, std::ios::binary | std::ios::ate);
+    if (!ifs.is_open()) {
+        throw std::runtime_error("Failed to open file!");
+    }
+    size_t size = static_cast<size_t>(ifs.tellg());
+    char *data = size ? new char[size] : nullptr;
+    ifs.seekg(0);
+    ifs.read(data, size);
+    return {data, size};
+}
+
+void MappedFile::unmapFile(MappedFile& mappedFile) {
+    delete[] static_cast<char *>(mappedFile.m_data);
+    mappedFile.m_data = nullptr;
+    mappedFile.m_size = 0;
+}
+
+#endif
+
+const void *MappedFile::data() const {
+    return m_data;
+}
+
+size_t MappedFile::size() const {
+    return m_size;
+}
+
+} // namespace gl
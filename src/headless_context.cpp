@@ -0,0 +1,160 @@
+#ifdef OPENGL_HPP_EGL
+
+#include "headless_context.hpp"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace gl {
+
+static bool hasExtension(const char *extensions, const char *name) {
+    if (!extensions) {
+        return false;
+    }
+    size_t length = std::strlen(name);
+    for (const char *itr = std::strstr(extensions, name); itr; itr = std::strstr(itr + length, name)) {
+        bool start = itr == extensions || itr[-1] == ' ';
+        bool end = itr[length] == ' ' || itr[length] == '\0';
+        if (start && end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static EGLDisplay openDisplay() {
+    const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+            return display;
+        }
+    }
+    auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+    if (getPlatformDisplay && queryDevices && hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+        EGLDeviceEXT device;
+        EGLint deviceCount = 0;
+        if (queryDevices(1, &device, &deviceCount) && deviceCount > 0) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+            if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+                return display;
+            }
+        }
+    }
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+        return display;
+    }
+    throw std::runtime_error("Failed to initialise an EGL display!");
+}
+
+HeadlessContext::HeadlessContext(const HeadlessContextCreateInfo& createInfo)
+  : m_display(EGL_NO_DISPLAY), m_context(EGL_NO_CONTEXT), m_surface(EGL_NO_SURFACE), m_ownsDisplay(!createInfo.share) {
+    m_display = createInfo.share ? createInfo.share->m_display : openDisplay();
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        destroy();
+        throw std::runtime_error("Failed to bind the OpenGL API!");
+    }
+
+    // without surfaceless contexts a 1x1 pbuffer stands in as the draw surface
+    bool surfaceless = hasExtension(eglQueryString(m_display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE,
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(m_display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        destroy();
+        throw std::runtime_error("Failed to find an EGL config!");
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, createInfo.majorVersion,
+        EGL_CONTEXT_MINOR_VERSION, createInfo.minorVersion,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_CONTEXT_OPENGL_DEBUG, createInfo.debug ? EGL_TRUE : EGL_FALSE,
+        EGL_NONE,
+    };
+    EGLContext share = createInfo.share ? createInfo.share->m_context : EGL_NO_CONTEXT;
+    m_context = eglCreateContext(m_display, config, share, contextAttribs);
+    if (m_context == EGL_NO_CONTEXT) {
+        destroy();
+        throw std::runtime_error("Failed to create an EGL context!");
+    }
+
+    if (!surfaceless) {
+        const EGLint pbufferAttribs[] = {
+            EGL_WIDTH, 1,
+            EGL_HEIGHT, 1,
+            EGL_NONE,
+        };
+        m_surface = eglCreatePbufferSurface(m_display, config, pbufferAttribs);
+        if (m_surface == EGL_NO_SURFACE) {
+            destroy();
+            throw std::runtime_error("Failed to create an EGL pbuffer!");
+        }
+    }
+
+    makeCurrent();
+    if (createInfo.loadGlad && !gladLoadGLLoader(getProcAddress)) {
+        destroy();
+        throw std::runtime_error("Failed to load OpenGL!");
+    }
+    m_dispatch.load(getProcAddress);
+}
+
+HeadlessContext::~HeadlessContext() {
+    destroy();
+}
+
+void HeadlessContext::destroy() {
+    if (m_display == EGL_NO_DISPLAY) {
+        return;
+    }
+    if (eglGetCurrentContext() == m_context) {
+        releaseCurrent();
+    }
+    if (m_surface != EGL_NO_SURFACE) {
+        eglDestroySurface(m_display, m_surface);
+    }
+    if (m_context != EGL_NO_CONTEXT) {
+        eglDestroyContext(m_display, m_context);
+    }
+    // displays are not reference counted, only the context that opened it may terminate it
+    if (m_ownsDisplay) {
+        eglTerminate(m_display);
+    }
+    m_display = EGL_NO_DISPLAY;
+}
+
+void HeadlessContext::makeCurrent() const {
+    if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context)) {
+        throw std::runtime_error("Failed to make the EGL context current!");
+    }
+}
+
+void HeadlessContext::releaseCurrent() const {
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+const Dispatch& HeadlessContext::getDispatch() const {
+    return m_dispatch;
+}
+
+void *HeadlessContext::getProcAddress(const char *name) {
+    return reinterpret_cast<void *>(eglGetProcAddress(name));
+}
+
+} // namespace gl
+
+#endif
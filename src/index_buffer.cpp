@@ -0,0 +1,155 @@
+#include "index_buffer.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace gl {
+
+IndexType selectIndexType(size_t vertexCount, IndexType smallest) {
+    if (vertexCount <= 0xff && smallest == IndexType::eUnsignedByte) {
+        return IndexType::eUnsignedByte;
+    }
+    if (vertexCount <= 0xffff && smallest != IndexType::eUnsignedInt) {
+        return IndexType::eUnsignedShort;
+    }
+    return IndexType::eUnsignedInt;
+}
+
+size_t getIndexSize(IndexType type) {
+    switch (type) {
+        case IndexType::eUnsignedByte:
+            return 1;
+        case IndexType::eUnsignedShort:
+            return 2;
+        case IndexType::eUnsignedInt:
+            return 4;
+    }
+    return 4;
+}
+
+#ifdef OPENGL_HPP_AVX2
+
+// the shuffles keep the low bytes of every index, which is exact for indices in range and turns restart into restart
+OPENGL_HPP_TARGET_AVX2 static size_t narrowAVX2(void *dst, const uint32_t *indices, size_t indexCount, IndexType type) {
+    size_t i = 0;
+    if (type == IndexType::eUnsignedShort) {
+        const __m256i low = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1);
+        auto *out = static_cast<uint16_t *>(dst);
+        for (; i + 16 <= indexCount; i += 16) {
+            __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i)), low);
+            __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i + 8)), low);
+            a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+            b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3, 1, 2, 0));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_permute2x128_si256(a, b, 0x20));
+        }
+    } else {
+        const __m256i low = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                             0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m256i order = _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4);
+        auto *out = static_cast<uint8_t *>(dst);
+        for (; i + 8 <= indexCount; i += 8) {
+            __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices + i)), low);
+            a = _mm256_permutevar8x32_epi32(a, order);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out + i), _mm256_castsi256_si128(a));
+        }
+    }
+    return i;
+}
+
+#endif
+
+#ifdef OPENGL_HPP_NEON
+
+static size_t narrowNEON(void *dst, const uint32_t *indices, size_t indexCount, IndexType type) {
+    size_t i = 0;
+    for (; i + 8 <= indexCount; i += 8) {
+        uint16x8_t narrowed = vcombine_u16(vmovn_u32(vld1q_u32(indices + i)), vmovn_u32(vld1q_u32(indices + i + 4)));
+        if (type == IndexType::eUnsignedShort) {
+            vst1q_u16(static_cast<uint16_t *>(dst) + i, narrowed);
+        } else {
+            vst1_u8(static_cast<uint8_t *>(dst) + i, vmovn_u16(narrowed));
+        }
+    }
+    return i;
+}
+
+#endif
+
+void narrowIndices(void *dst, const uint32_t *indices, size_t indexCount, IndexType type) {
+    if (type == IndexType::eUnsignedInt) {
+        std::copy(indices, indices + indexCount, static_cast<uint32_t *>(dst));
+        return;
+    }
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = narrowAVX2(dst, indices, indexCount, type);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = narrowNEON(dst, indices, indexCount, type);
+#endif
+    for (; i < indexCount; i++) {
+        if (type == IndexType::eUnsignedShort) {
+            static_cast<uint16_t *>(dst)[i] = uint16_t(indices[i]);
+        } else {
+            static_cast<uint8_t *>(dst)[i] = uint8_t(indices[i]);
+        }
+    }
+}
+
+IndexBuffer::IndexBuffer(Buffer buffer, IndexType type, size_t count) : m_buffer(buffer), m_type(type), m_count(count) {}
+
+IndexBuffer IndexBuffer::createIndexBuffer(const uint32_t *indices, size_t indexCount, size_t vertexCount, BufferStorage flags, IndexType smallest, const Dispatch& d) {
+    IndexType type = selectIndexType(vertexCount, smallest);
+    Buffer buffer = Buffer::createBuffer(d);
+    if (type == IndexType::eUnsignedInt) {
+        buffer.storage(indexCount * 4, indices, flags, d);
+    } else {
+        std::vector<uint8_t> narrowed(indexCount * getIndexSize(type));
+        narrowIndices(narrowed.data(), indices, indexCount, type);
+        buffer.storage(narrowed.size(), narrowed.data(), flags, d);
+    }
+    return IndexBuffer(buffer, type, indexCount);
+}
+
+void IndexBuffer::deleteIndexBuffer(IndexBuffer& indexBuffer, const Dispatch& d) {
+    Buffer::deleteBuffer(indexBuffer.m_buffer, d);
+    indexBuffer.m_count = 0;
+}
+
+void IndexBuffer::attach(VertexArray& vertexArray, const Dispatch& d) const {
+    Buffer buffer = m_buffer;
+    vertexArray.elementBuffer(buffer, d);
+}
+
+Buffer IndexBuffer::getBuffer() const {
+    return m_buffer;
+}
+
+IndexType IndexBuffer::getType() const {
+    return m_type;
+}
+
+size_t IndexBuffer::getCount() const {
+    return m_count;
+}
+
+size_t IndexBuffer::getOffset(size_t first) const {
+    return first * getIndexSize(m_type);
+}
+
+void drawElements(Primitive mode, const IndexBuffer& indexBuffer, const Dispatch& d) {
+    drawElements(mode, indexBuffer.getCount(), indexBuffer.getType(), nullptr, d);
+}
+
+void drawElements(Primitive mode, const IndexBuffer& indexBuffer, size_t first, size_t count, const Dispatch& d) {
+    drawElements(mode, count, indexBuffer.getType(), reinterpret_cast<const void *>(indexBuffer.getOffset(first)), d);
+}
+
+void drawElementsInstanced(Primitive mode, const IndexBuffer& indexBuffer, size_t instanceCount, uint32_t baseInstance, const Dispatch& d) {
+    drawElementsInstancedBaseVertexBaseInstance(mode, indexBuffer.getCount(), indexBuffer.getType(), nullptr, instanceCount, 0, baseInstance, d);
+}
+
+} // namespace gl
@@ -0,0 +1,310 @@
+#include "instance_culler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gl {
+
+// declarations every pass shares
+static const char *commonSource = R"(
+struct Instance {
+    vec4 sphere;
+    uint mesh;
+};
+
+// first index, index count, base vertex
+layout(std430, binding = FIRST_BINDING) readonly buffer Meshes {
+    uvec4 meshes[];
+};
+layout(std430, binding = FIRST_BINDING + 1) readonly buffer Instances {
+    Instance instances[];
+};
+// tightly packed DrawElementsIndirectCommands, one per mesh with visible instances
+layout(std430, binding = FIRST_BINDING + 2) writeonly buffer Commands {
+    uint commands[];
+};
+layout(std430, binding = FIRST_BINDING + 3) buffer Count {
+    uint drawCount;
+};
+// visible instances per mesh, counted by the cull pass and zeroed again by the build pass
+layout(std430, binding = FIRST_BINDING + 4) buffer MeshCounts {
+    uint meshCounts[];
+};
+// per instance, its index among the visible instances of its mesh or ~0 when culled
+layout(std430, binding = FIRST_BINDING + 5) buffer Slots {
+    uint slots[];
+};
+// per mesh, where its visible instance ids start
+layout(std430, binding = FIRST_BINDING + 6) buffer MeshFirsts {
+    uint meshFirsts[];
+};
+layout(std430, binding = FIRST_BINDING + 7) writeonly buffer Visible {
+    uint visible[];
+};
+layout(std140, binding = UNIFORM_BINDING) uniform InstanceCullParams {
+    mat4 viewProjection;
+    vec4 planes[6];
+    // width, height, level count, occlusion culling enabled
+    vec4 pyramid;
+    // instance count, mesh count
+    uvec4 counts;
+};
+)";
+
+static const char *cullSource = R"(
+layout(local_size_x = 64) in;
+layout(binding = TEXTURE_UNIT) uniform sampler2D depthPyramid;
+
+bool isVisible(uint id) {
+    Instance instance = instances[id];
+    if (instance.mesh >= counts.y) {
+        return false;
+    }
+    vec3 center = instance.sphere.xyz;
+    float radius = instance.sphere.w;
+    for (int i = 0; i < 6; i++) {
+        if (dot(planes[i].xyz, center) + planes[i].w < -radius) {
+            return false;
+        }
+    }
+    return pyramid.w == 0.0 || !depthPyramidOccluded(depthPyramid, pyramid.xyz, viewProjection, center, radius);
+}
+
+void main() {
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= counts.x) {
+        return;
+    }
+    slots[id] = isVisible(id) ? atomicAdd(meshCounts[instances[id].mesh], 1u) : 0xffffffffu;
+}
+)";
+
+// a single group, each invocation owns a run of meshes and the runs are scanned in shared memory
+static const char *buildSource = R"(
+layout(local_size_x = 256) in;
+
+// visible instances and meshes with any, up to and including each invocation's run
+shared uvec2 sums[256];
+
+void main() {
+    uint t = gl_LocalInvocationIndex;
+    uint run = (counts.y + 255u) / 256u;
+    uint first = min(t * run, counts.y);
+    uint last = min(first + run, counts.y);
+    uvec2 total = uvec2(0u);
+    for (uint mesh = first; mesh < last; mesh++) {
+        uint count = meshCounts[mesh];
+        total += uvec2(count, count != 0u ? 1u : 0u);
+    }
+    sums[t] = total;
+    memoryBarrierShared();
+    barrier();
+    for (uint offset = 1u; offset < 256u; offset *= 2u) {
+        uvec2 add = t >= offset ? sums[t - offset] : uvec2(0u);
+        memoryBarrierShared();
+        barrier();
+        sums[t] += add;
+        memoryBarrierShared();
+        barrier();
+    }
+    // x is the first visible id of the run, y its first command
+    uvec2 next = sums[t] - total;
+    for (uint mesh = first; mesh < last; mesh++) {
+        uint count = meshCounts[mesh];
+        meshFirsts[mesh] = next.x;
+        if (count != 0u) {
+            uvec4 range = meshes[mesh];
+            uint slot = next.y * 5u;
+            commands[slot + 0u] = range.y;
+            commands[slot + 1u] = count;
+            commands[slot + 2u] = range.x;
+            commands[slot + 3u] = range.z;
+            commands[slot + 4u] = next.x;
+            next.y++;
+        }
+        next.x += count;
+        // ready for the next cull
+        meshCounts[mesh] = 0u;
+    }
+    if (t == 255u) {
+        drawCount = sums[255].y;
+    }
+}
+)";
+
+static const char *scatterSource = R"(
+layout(local_size_x = 64) in;
+
+void main() {
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= counts.x || slots[id] == 0xffffffffu) {
+        return;
+    }
+    visible[meshFirsts[instances[id].mesh] + slots[id]] = id;
+}
+)";
+
+// matches the InstanceCullParams block above
+struct CullParams {
+    float viewProjection[16];
+    float planes[6][4];
+    float pyramid[4];
+    uint32_t counts[4];
+};
+
+static Program createComputeProgram(const InstanceCuller::CreateInfo& info, const char *body, const Dispatch& d) {
+    std::string source = "#version 450\n";
+    source += "#define FIRST_BINDING " + std::to_string(info.firstBinding) + "\n";
+    source += "#define UNIFORM_BINDING " + std::to_string(info.uniformBinding) + "\n";
+    source += "#define TEXTURE_UNIT " + std::to_string(info.textureUnit) + "\n";
+    source += commonSource;
+    source += DepthPyramid::getOcclusionGLSL();
+    source += body;
+    Program program = Program::createShaderProgram(ShaderType::eCompute, 1, source.c_str(), d);
+    if (!program.getiv(ProgramIV::eLinkStatus, d)) {
+        std::string log = program.getInfoLog(d);
+        Program::deleteProgram(program, d);
+        throw std::runtime_error("Failed to build the InstanceCuller shaders!\n" + log);
+    }
+    return program;
+}
+
+static const InstanceCuller::CreateInfo& checkedInfo(const InstanceCuller::CreateInfo& info) {
+    if (!info.meshes || info.meshCount == 0 || info.maxInstances == 0) {
+        throw std::runtime_error("Failed to create InstanceCuller, it needs at least one mesh and instance!");
+    }
+    return info;
+}
+
+InstanceCuller::InstanceCuller(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(checkedInfo(createInfo)),
+    m_instanceCount(0),
+    m_meshes(Buffer::createBuffer(d)),
+    m_instances(Buffer::createBuffer(d)),
+    m_commands(Buffer::createBuffer(d)),
+    m_count(Buffer::createBuffer(d)),
+    m_meshCounts(Buffer::createBuffer(d)),
+    m_slots(Buffer::createBuffer(d)),
+    m_meshFirsts(Buffer::createBuffer(d)),
+    m_visible(Buffer::createBuffer(d)),
+    m_uniforms(Buffer::createBuffer(d)),
+    m_cull(createComputeProgram(createInfo, cullSource, d)),
+    m_build(createComputeProgram(createInfo, buildSource, d)),
+    m_scatter(createComputeProgram(createInfo, scatterSource, d)) {
+    std::vector<uint32_t> meshes(m_info.meshCount * 4, 0);
+    for (size_t i = 0; i < m_info.meshCount; i++) {
+        meshes[i * 4 + 0] = m_info.meshes[i].firstIndex;
+        meshes[i * 4 + 1] = m_info.meshes[i].indexCount;
+        meshes[i * 4 + 2] = uint32_t(m_info.meshes[i].baseVertex);
+    }
+    m_meshes.storage(meshes.size() * sizeof(uint32_t), meshes.data(), BufferStorage::eNone, d);
+    m_instances.storage(m_info.maxInstances * sizeof(InstanceBounds), nullptr, BufferStorage::eDynamic, d);
+    m_commands.storage(m_info.meshCount * sizeof(DrawElementsIndirectCommand), nullptr, BufferStorage::eNone, d);
+    uint32_t zero = 0;
+    m_count.storage(sizeof(zero), &zero, BufferStorage::eDynamic, d);
+    // starts zeroed, afterwards every build pass leaves it zeroed
+    std::vector<uint32_t> zeros(m_info.meshCount, 0);
+    m_meshCounts.storage(zeros.size() * sizeof(uint32_t), zeros.data(), BufferStorage::eNone, d);
+    m_slots.storage(m_info.maxInstances * sizeof(uint32_t), nullptr, BufferStorage::eNone, d);
+    m_meshFirsts.storage(m_info.meshCount * sizeof(uint32_t), nullptr, BufferStorage::eNone, d);
+    m_visible.storage(m_info.maxInstances * sizeof(uint32_t), nullptr, BufferStorage::eNone, d);
+    m_uniforms.storage(sizeof(CullParams), nullptr, BufferStorage::eDynamic, d);
+    // the meshes are only read here, the caller may free them
+    m_info.meshes = nullptr;
+}
+
+InstanceCuller::~InstanceCuller() {
+    Program::deleteProgram(m_scatter, *m_dispatch);
+    Program::deleteProgram(m_build, *m_dispatch);
+    Program::deleteProgram(m_cull, *m_dispatch);
+    Buffer::deleteBuffer(m_uniforms, *m_dispatch);
+    Buffer::deleteBuffer(m_visible, *m_dispatch);
+    Buffer::deleteBuffer(m_meshFirsts, *m_dispatch);
+    Buffer::deleteBuffer(m_slots, *m_dispatch);
+    Buffer::deleteBuffer(m_meshCounts, *m_dispatch);
+    Buffer::deleteBuffer(m_count, *m_dispatch);
+    Buffer::deleteBuffer(m_commands, *m_dispatch);
+    Buffer::deleteBuffer(m_instances, *m_dispatch);
+    Buffer::deleteBuffer(m_meshes, *m_dispatch);
+}
+
+void InstanceCuller::setInstances(size_t first, size_t count, const InstanceBounds *instances) {
+    if (first + count > m_info.maxInstances) {
+        throw std::runtime_error("Failed to set instances, the range passes maxInstances!");
+    }
+    m_instances.subData(first * sizeof(InstanceBounds), count * sizeof(InstanceBounds), instances, *m_dispatch);
+}
+
+void InstanceCuller::setInstanceCount(size_t count) {
+    m_instanceCount = std::min(count, m_info.maxInstances);
+}
+
+void InstanceCuller::cull(const View& view) {
+    const Dispatch& d = *m_dispatch;
+    CullParams params = {};
+    std::copy(view.viewProjection, view.viewProjection + 16, params.viewProjection);
+    extractFrustumPlanes(view.viewProjection, params.planes);
+    if (view.pyramid) {
+        params.pyramid[0] = float(view.pyramid->getWidth());
+        params.pyramid[1] = float(view.pyramid->getHeight());
+        params.pyramid[2] = float(view.pyramid->getLevelCount());
+        params.pyramid[3] = 1.0f;
+        view.pyramid->bindUnit(m_info.textureUnit);
+    }
+    params.counts[0] = uint32_t(m_instanceCount);
+    params.counts[1] = uint32_t(m_info.meshCount);
+    m_uniforms.subData(0, sizeof(params), &params, d);
+    if (m_instanceCount == 0) {
+        // the build pass writes the count otherwise
+        uint32_t zero = 0;
+        m_count.subData(0, sizeof(zero), &zero, d);
+        return;
+    }
+
+    const Buffer buffers[] = {m_meshes, m_instances, m_commands, m_count, m_meshCounts, m_slots, m_meshFirsts, m_visible};
+    Buffer::bindBuffersBase(IndexedBufferTarget::eShaderStorage, m_info.firstBinding, 8, buffers, d);
+    m_uniforms.bindBase(IndexedBufferTarget::eUniform, m_info.uniformBinding, d);
+    uint32_t groups = uint32_t((m_instanceCount + 63) / 64);
+    m_cull.use(d);
+    dispatchCompute(groups, 1, 1, d);
+    memoryBarrier(MemoryBarrierBits::eShaderStorage, d);
+    m_build.use(d);
+    dispatchCompute(1, 1, 1, d);
+    memoryBarrier(MemoryBarrierBits::eShaderStorage, d);
+    m_scatter.use(d);
+    dispatchCompute(groups, 1, 1, d);
+    memoryBarrier(MemoryBarrierBits::eCommand | MemoryBarrierBits::eShaderStorage | MemoryBarrierBits::eVertexAttribArray, d);
+    Program::useNone(d);
+}
+
+void InstanceCuller::draw(Primitive mode) {
+    const Dispatch& d = *m_dispatch;
+    m_commands.bind(BufferTarget::eDrawIndirect, d);
+    m_count.bind(BufferTarget::eParameter, d);
+    multiDrawElementsIndirectCount(mode, m_info.indexType, 0, 0, m_info.meshCount, sizeof(DrawElementsIndirectCommand), d);
+}
+
+Buffer InstanceCuller::getInstanceBuffer() const {
+    return m_instances;
+}
+
+Buffer InstanceCuller::getCommandBuffer() const {
+    return m_commands;
+}
+
+Buffer InstanceCuller::getCountBuffer() const {
+    return m_count;
+}
+
+Buffer InstanceCuller::getVisibleBuffer() const {
+    return m_visible;
+}
+
+size_t InstanceCuller::getInstanceCount() const {
+    return m_instanceCount;
+}
+
+} // namespace gl
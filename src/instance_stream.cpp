@@ -0,0 +1,81 @@
+#include "instance_stream.hpp"
+
+#include <stdexcept>
+
+namespace gl {
+
+static const InstanceStream::CreateInfo& checkedInfo(const InstanceStream::CreateInfo& info) {
+    if (info.instanceSize == 0 || info.maxInstancesPerFrame == 0 || info.frameCount == 0) {
+        throw std::runtime_error("Failed to create InstanceStream, the sizes must not be zero!");
+    }
+    // baseInstance indexes the whole ring
+    if (info.maxInstancesPerFrame * info.frameCount > UINT32_MAX) {
+        throw std::runtime_error("Failed to create InstanceStream, the ring holds too many instances!");
+    }
+    return info;
+}
+
+InstanceStream::InstanceStream(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(checkedInfo(createInfo)),
+    m_buffer(Buffer::createBuffer(d)),
+    m_mapped(nullptr),
+    // the first beginFrame() moves to slot 0
+    m_frame(createInfo.frameCount - 1),
+    m_head(0),
+    m_fences(createInfo.frameCount, nullptr) {
+    size_t size = m_info.instanceSize * m_info.maxInstancesPerFrame * m_info.frameCount;
+    m_buffer.storage(size, nullptr, BufferStorage::eWrite | BufferStorage::ePersistent | BufferStorage::eCoherent, d);
+    m_mapped = static_cast<uint8_t *>(m_buffer.mapRange(0, size, BufferMap::eWrite | BufferMap::ePersistent | BufferMap::eCoherent, d));
+}
+
+InstanceStream::~InstanceStream() {
+    for (GLsync fence : m_fences) {
+        if (fence) {
+            m_dispatch->glDeleteSync(fence);
+        }
+    }
+    m_buffer.unmap(*m_dispatch);
+    Buffer::deleteBuffer(m_buffer, *m_dispatch);
+}
+
+void InstanceStream::beginFrame() {
+    m_frame = (m_frame + 1) % m_info.frameCount;
+    m_head = 0;
+    GLsync& fence = m_fences[m_frame];
+    if (fence) {
+        m_dispatch->glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        m_dispatch->glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void *InstanceStream::allocate(size_t count, uint32_t& baseInstance) {
+    if (m_head + count > m_info.maxInstancesPerFrame) {
+        throw std::runtime_error("Failed to allocate instances, the frame's slot is full!");
+    }
+    size_t first = m_frame * m_info.maxInstancesPerFrame + m_head;
+    m_head += count;
+    baseInstance = uint32_t(first);
+    return m_mapped + first * m_info.instanceSize;
+}
+
+void InstanceStream::endFrame() {
+    GLsync& fence = m_fences[m_frame];
+    if (fence) {
+        m_dispatch->glDeleteSync(fence);
+    }
+    fence = m_dispatch->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void InstanceStream::bind(VertexArray& vertexArray, uint32_t bindingIndex) const {
+    Buffer buffer = m_buffer;
+    vertexArray.vertexBuffer(bindingIndex, buffer, 0, m_info.instanceSize, *m_dispatch);
+    vertexArray.bindingDivisor(bindingIndex, 1, *m_dispatch);
+}
+
+Buffer InstanceStream::getBuffer() const {
+    return m_buffer;
+}
+
+} // namespace gl
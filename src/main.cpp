@@ -81,7 +81,8 @@ int main() {
 
     glfwMakeContextCurrent(window);                     
 
-    gladLoadGL();
+    // resolves only the entry points the gl:: layer uses, each on its first call
+    gl::defaultDispatch.loadLazy((GLADloadproc)glfwGetProcAddress);
 
     gl::Shader vertShader = gl::Shader::createShader(gl::ShaderType::eVertex);
     vertShader.source(1, readFile("../shaders/test.vert").c_str(), NULL);
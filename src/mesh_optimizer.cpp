@@ -0,0 +1,408 @@
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace gl {
+
+// triangles around each vertex, the live ones are kept at the front of every range
+struct Adjacency {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> triangles;
+};
+
+static Adjacency buildAdjacency(const uint32_t *indices, size_t indexCount, size_t vertexCount) {
+    Adjacency adjacency;
+    adjacency.offsets.resize(vertexCount);
+    adjacency.counts.assign(vertexCount, 0);
+    adjacency.triangles.resize(indexCount);
+    for (size_t i = 0; i < indexCount; i++) {
+        adjacency.counts[indices[i]]++;
+    }
+    uint32_t offset = 0;
+    for (size_t v = 0; v < vertexCount; v++) {
+        adjacency.offsets[v] = offset;
+        offset += adjacency.counts[v];
+    }
+    std::vector<uint32_t> fill = adjacency.offsets;
+    for (size_t i = 0; i < indexCount; i++) {
+        adjacency.triangles[fill[indices[i]]++] = uint32_t(i / 3);
+    }
+    return adjacency;
+}
+
+VertexCacheStats analyzeVertexCache(const uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize) {
+    VertexCacheStats stats = {};
+    // a vertex is in the cache while fewer than cacheSize misses happened since it was loaded
+    std::vector<size_t> loadedAt(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    size_t misses = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        uint32_t v = indices[i];
+        if (!referenced[v]) {
+            referenced[v] = true;
+            stats.uniqueVertices++;
+        }
+        if (loadedAt[v] == 0 || misses - loadedAt[v] + 1 > cacheSize) {
+            misses++;
+            loadedAt[v] = misses;
+        }
+    }
+    stats.transformedVertices = misses;
+    stats.triangleCount = indexCount / 3;
+    stats.acmr = stats.triangleCount ? float(misses) / stats.triangleCount : 0.0f;
+    stats.atvr = stats.uniqueVertices ? float(misses) / stats.uniqueVertices : 0.0f;
+    return stats;
+}
+
+static constexpr uint32_t forsythCacheSize = 32;
+static constexpr uint32_t notCached = forsythCacheSize;
+
+// scores from the original write up, recently used vertices and vertices with few triangles left rank highest
+static float forsythVertexScore(uint32_t cachePosition, uint32_t remaining) {
+    struct Tables {
+        float cache[forsythCacheSize + 1];
+        float valence[64];
+
+        Tables() {
+            for (uint32_t i = 0; i <= forsythCacheSize; i++) {
+                if (i == notCached) {
+                    cache[i] = 0.0f;
+                } else if (i < 3) {
+                    // the last triangle's vertices score the same, whatever order they went in
+                    cache[i] = 0.75f;
+                } else {
+                    cache[i] = std::pow(1.0f - float(i - 3) / (forsythCacheSize - 3), 1.5f);
+                }
+            }
+            for (uint32_t i = 0; i < 64; i++) {
+                valence[i] = i ? 2.0f / std::sqrt(float(i)) : 0.0f;
+            }
+        }
+    };
+    static const Tables tables;
+    if (remaining == 0) {
+        return -1.0f;
+    }
+    return tables.cache[cachePosition] + (remaining < 64 ? tables.valence[remaining] : 2.0f / std::sqrt(float(remaining)));
+}
+
+void optimizeVertexCache(uint32_t *dst, const uint32_t *indices, size_t indexCount, size_t vertexCount) {
+    size_t triangleCount = indexCount / 3;
+    Adjacency adjacency = buildAdjacency(indices, indexCount, vertexCount);
+    std::vector<uint32_t> cachePosition(vertexCount, notCached);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        vertexScore[v] = forsythVertexScore(notCached, adjacency.counts[v]);
+    }
+    std::vector<float> triangleScore(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+    }
+    std::vector<bool> emitted(triangleCount, false);
+
+    // the first pick scans everything, afterwards only triangles around cached vertices are considered
+    size_t best = 0;
+    for (size_t t = 1; t < triangleCount; t++) {
+        if (triangleScore[t] > triangleScore[best]) {
+            best = t;
+        }
+    }
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(forsythCacheSize + 3);
+    nextCache.reserve(forsythCacheSize + 3);
+    size_t cursor = 0;
+    for (size_t output = 0; output < triangleCount; output++) {
+        if (best == std::numeric_limits<size_t>::max()) {
+            // dead end, continue with the next triangle in input order
+            while (emitted[cursor]) {
+                cursor++;
+            }
+            best = cursor;
+        }
+        const uint32_t *triangle = indices + best * 3;
+        std::copy(triangle, triangle + 3, dst + output * 3);
+        emitted[best] = true;
+
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = triangle[k];
+            uint32_t *begin = adjacency.triangles.data() + adjacency.offsets[v];
+            uint32_t *end = begin + adjacency.counts[v];
+            uint32_t *found = std::find(begin, end, uint32_t(best));
+            if (found != end) {
+                std::swap(*found, *(end - 1));
+                adjacency.counts[v]--;
+            }
+        }
+
+        // the emitted triangle moves to the front, everything that falls past the end leaves the cache
+        nextCache.assign(triangle, triangle + 3);
+        for (uint32_t v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                nextCache.push_back(v);
+            }
+        }
+        for (size_t i = 0; i < nextCache.size(); i++) {
+            uint32_t v = nextCache[i];
+            cachePosition[v] = i < forsythCacheSize ? uint32_t(i) : notCached;
+            float score = forsythVertexScore(cachePosition[v], adjacency.counts[v]);
+            float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+            const uint32_t *around = adjacency.triangles.data() + adjacency.offsets[v];
+            for (uint32_t j = 0; j < adjacency.counts[v]; j++) {
+                triangleScore[around[j]] += delta;
+            }
+        }
+        if (nextCache.size() > forsythCacheSize) {
+            nextCache.resize(forsythCacheSize);
+        }
+        std::swap(cache, nextCache);
+
+        best = std::numeric_limits<size_t>::max();
+        float bestScore = -std::numeric_limits<float>::max();
+        for (uint32_t v : cache) {
+            const uint32_t *around = adjacency.triangles.data() + adjacency.offsets[v];
+            for (uint32_t j = 0; j < adjacency.counts[v]; j++) {
+                if (triangleScore[around[j]] > bestScore) {
+                    bestScore = triangleScore[around[j]];
+                    best = around[j];
+                }
+            }
+        }
+    }
+}
+
+void optimizeVertexCacheTipsify(uint32_t *dst, const uint32_t *indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize) {
+    size_t triangleCount = indexCount / 3;
+    Adjacency adjacency = buildAdjacency(indices, indexCount, vertexCount);
+    // live triangles per vertex
+    std::vector<uint32_t> live = adjacency.counts;
+    std::vector<size_t> timestamp(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    size_t time = cacheSize + 1;
+    size_t cursor = 0;
+    size_t output = 0;
+
+    // start from the first referenced vertex
+    size_t fan = 0;
+    while (fan < vertexCount && live[fan] == 0) {
+        fan++;
+    }
+    while (fan < vertexCount) {
+        candidates.clear();
+        const uint32_t *around = adjacency.triangles.data() + adjacency.offsets[fan];
+        for (uint32_t j = 0; j < adjacency.counts[fan]; j++) {
+            uint32_t t = around[j];
+            if (emitted[t]) {
+                continue;
+            }
+            emitted[t] = true;
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = indices[t * 3 + k];
+                dst[output++] = v;
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                if (time - timestamp[v] > cacheSize) {
+                    timestamp[v] = time++;
+                }
+            }
+        }
+
+        // prefer the candidate that is still cached and stays cached while its remaining triangles go out
+        size_t next = vertexCount;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (live[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            if (int64_t(time - timestamp[v]) + 2 * int64_t(live[v]) <= int64_t(cacheSize)) {
+                priority = int64_t(time - timestamp[v]);
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+        if (next == vertexCount) {
+            // dead end, walk back through recently used vertices, then fall back to input order
+            while (!deadEnd.empty() && next == vertexCount) {
+                uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0) {
+                    next = v;
+                }
+            }
+            while (next == vertexCount && cursor < vertexCount) {
+                if (live[cursor] > 0) {
+                    next = cursor;
+                }
+                cursor++;
+            }
+        }
+        fan = next;
+    }
+}
+
+void optimizeOverdraw(uint32_t *dst, const uint32_t *indices, size_t indexCount, const float *positions, size_t vertexCount, size_t positionStride, float threshold) {
+    size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    const uint32_t cacheSize = 16;
+
+    // hard boundaries are where the cache order jumps, all three vertices of a triangle missing
+    // the misses up to each one give every hard cluster its acmr from the same simulation
+    std::vector<size_t> hard;
+    std::vector<size_t> missesBefore;
+    std::vector<size_t> loadedAt(vertexCount, 0);
+    size_t misses = 0;
+    for (size_t t = 0; t < triangleCount; t++) {
+        size_t missesBeforeTriangle = misses;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[t * 3 + k];
+            if (loadedAt[v] == 0 || misses - loadedAt[v] + 1 > cacheSize) {
+                loadedAt[v] = ++misses;
+            }
+        }
+        if (t == 0 || misses - missesBeforeTriangle == 3) {
+            hard.push_back(t);
+            missesBefore.push_back(missesBeforeTriangle);
+        }
+    }
+    hard.push_back(triangleCount);
+    missesBefore.push_back(misses);
+
+    // soft boundaries cut a hard cluster again wherever the acmr so far is within threshold of the whole cluster's
+    // loadedAt is cleared once here and after that only through the vertices each cluster touched
+    std::fill(loadedAt.begin(), loadedAt.end(), 0);
+    std::vector<uint32_t> touched;
+    std::vector<size_t> clusters;
+    for (size_t h = 0; h + 1 < hard.size(); h++) {
+        size_t begin = hard[h];
+        size_t end = hard[h + 1];
+        float wholeACMR = float(missesBefore[h + 1] - missesBefore[h]) / float(end - begin);
+        size_t start = begin;
+        misses = 0;
+        for (uint32_t v : touched) {
+            loadedAt[v] = 0;
+        }
+        touched.clear();
+        clusters.push_back(begin);
+        for (size_t t = begin; t < end; t++) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t v = indices[t * 3 + k];
+                if (loadedAt[v] == 0 || misses - loadedAt[v] + 1 > cacheSize) {
+                    if (loadedAt[v] == 0) {
+                        touched.push_back(v);
+                    }
+                    loadedAt[v] = ++misses;
+                }
+            }
+            float acmr = float(misses) / float(t - start + 1);
+            if (t + 1 < end && acmr <= wholeACMR * threshold) {
+                clusters.push_back(t + 1);
+                start = t + 1;
+                misses = 0;
+                for (uint32_t v : touched) {
+                    loadedAt[v] = 0;
+                }
+                touched.clear();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    auto position = [&](uint32_t v) {
+        return reinterpret_cast<const float *>(reinterpret_cast<const uint8_t *>(positions) + v * positionStride);
+    };
+    float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < indexCount; i++) {
+        for (int c = 0; c < 3; c++) {
+            meshCentroid[c] += position(indices[i])[c] / float(indexCount);
+        }
+    }
+
+    // clusters facing away from the middle of the mesh tend to occlude the rest, so they sort first
+    struct Cluster {
+        size_t begin;
+        size_t end;
+        float sortKey;
+    };
+    std::vector<Cluster> sorted;
+    for (size_t c = 0; c + 1 < clusters.size(); c++) {
+        float centroid[3] = {0.0f, 0.0f, 0.0f};
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        float area = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            const float *p0 = position(indices[t * 3]);
+            const float *p1 = position(indices[t * 3 + 1]);
+            const float *p2 = position(indices[t * 3 + 2]);
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            float triangleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; k++) {
+                centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0f * triangleArea;
+                normal[k] += n[k];
+            }
+            area += triangleArea;
+        }
+        float key = 0.0f;
+        float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (area > 0.0f && normalLength > 0.0f) {
+            for (int k = 0; k < 3; k++) {
+                key += (centroid[k] / area - meshCentroid[k]) * normal[k] / normalLength;
+            }
+        }
+        sorted.push_back({clusters[c], clusters[c + 1], key});
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    size_t output = 0;
+    for (auto& cluster : sorted) {
+        std::copy(indices + cluster.begin * 3, indices + cluster.end * 3, dst + output);
+        output += (cluster.end - cluster.begin) * 3;
+    }
+}
+
+size_t optimizeVertexFetchRemap(uint32_t *remap, uint32_t *indices, size_t indexCount, size_t vertexCount) {
+    std::fill(remap, remap + vertexCount, std::numeric_limits<uint32_t>::max());
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        uint32_t& slot = remap[indices[i]];
+        if (slot == std::numeric_limits<uint32_t>::max()) {
+            slot = next++;
+        }
+        indices[i] = slot;
+    }
+    return next;
+}
+
+void remapVertices(void *dst, const void *src, size_t vertexCount, size_t vertexSize, const uint32_t *remap) {
+    for (size_t v = 0; v < vertexCount; v++) {
+        if (remap[v] != std::numeric_limits<uint32_t>::max()) {
+            std::memcpy(static_cast<uint8_t *>(dst) + remap[v] * vertexSize, static_cast<const uint8_t *>(src) + v * vertexSize, vertexSize);
+        }
+    }
+}
+
+size_t optimizeVertexFetch(uint32_t *indices, size_t indexCount, void *vertices, size_t vertexCount, size_t vertexSize) {
+    std::vector<uint32_t> remap(vertexCount);
+    size_t used = optimizeVertexFetchRemap(remap.data(), indices, indexCount, vertexCount);
+    std::vector<uint8_t> copy(static_cast<uint8_t *>(vertices), static_cast<uint8_t *>(vertices) + vertexCount * vertexSize);
+    remapVertices(vertices, copy.data(), vertexCount, vertexSize, remap.data());
+    return used;
+}
+
+} // namespace gl
@@ -0,0 +1,163 @@
+#include "meshlet_builder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace gl {
+
+static const float *position(const float *positions, size_t positionStride, uint32_t v) {
+    return reinterpret_cast<const float *>(reinterpret_cast<const uint8_t *>(positions) + v * positionStride);
+}
+
+static float distanceSquared(const float *a, const float *b) {
+    float x = a[0] - b[0];
+    float y = a[1] - b[1];
+    float z = a[2] - b[2];
+    return x * x + y * y + z * z;
+}
+
+MeshletBounds computeMeshletBounds(const uint32_t *indices, size_t indexCount, const float *positions, size_t vertexCount, size_t positionStride) {
+    (void)vertexCount;
+    MeshletBounds bounds = {};
+    bounds.coneAxis[2] = 1.0f;
+    bounds.coneCutoff = 1.0f;
+    if (indexCount == 0) {
+        return bounds;
+    }
+
+    // ritter's sphere, start from the most distant pair of the points extreme along each axis
+    const float *minPoint[3];
+    const float *maxPoint[3];
+    for (int axis = 0; axis < 3; axis++) {
+        minPoint[axis] = maxPoint[axis] = position(positions, positionStride, indices[0]);
+    }
+    for (size_t i = 1; i < indexCount; i++) {
+        const float *p = position(positions, positionStride, indices[i]);
+        for (int axis = 0; axis < 3; axis++) {
+            if (p[axis] < minPoint[axis][axis]) {
+                minPoint[axis] = p;
+            }
+            if (p[axis] > maxPoint[axis][axis]) {
+                maxPoint[axis] = p;
+            }
+        }
+    }
+    int widest = 0;
+    float widestDistance = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        float distance = distanceSquared(minPoint[axis], maxPoint[axis]);
+        if (distance > widestDistance) {
+            widest = axis;
+            widestDistance = distance;
+        }
+    }
+    float center[3];
+    for (int c = 0; c < 3; c++) {
+        center[c] = (minPoint[widest][c] + maxPoint[widest][c]) * 0.5f;
+    }
+    float radius = std::sqrt(widestDistance) * 0.5f;
+    for (size_t i = 0; i < indexCount; i++) {
+        const float *p = position(positions, positionStride, indices[i]);
+        float distance = distanceSquared(p, center);
+        if (distance > radius * radius) {
+            // move the sphere towards p just far enough to take it in
+            distance = std::sqrt(distance);
+            float grown = (radius + distance) * 0.5f;
+            float shift = (grown - radius) / distance;
+            for (int c = 0; c < 3; c++) {
+                center[c] += (p[c] - center[c]) * shift;
+            }
+            radius = grown;
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        bounds.center[c] = center[c];
+    }
+    bounds.radius = radius;
+
+    // normal cone around the average of the unit triangle normals, degenerate triangles do not take part
+    std::vector<float> normals;
+    normals.reserve(indexCount);
+    float axis[3] = {0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const float *a = position(positions, positionStride, indices[i + 0]);
+        const float *b = position(positions, positionStride, indices[i + 1]);
+        const float *c = position(positions, positionStride, indices[i + 2]);
+        float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length == 0.0f) {
+            continue;
+        }
+        for (int k = 0; k < 3; k++) {
+            normals.push_back(n[k] / length);
+            axis[k] += n[k] / length;
+        }
+    }
+    float axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    if (normals.empty() || axisLength == 0.0f) {
+        return bounds;
+    }
+    float minDot = 1.0f;
+    for (size_t i = 0; i < normals.size(); i += 3) {
+        float dot = (normals[i] * axis[0] + normals[i + 1] * axis[1] + normals[i + 2] * axis[2]) / axisLength;
+        minDot = std::min(minDot, dot);
+    }
+    for (int k = 0; k < 3; k++) {
+        bounds.coneAxis[k] = axis[k] / axisLength;
+    }
+    // past about 84 degrees of spread no view direction sees only back faces
+    if (minDot > 0.1f) {
+        bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+    return bounds;
+}
+
+MeshletMesh buildMeshlets(const uint32_t *indices, size_t indexCount, const float *positions, size_t vertexCount, size_t positionStride,
+                          uint32_t maxVertices, uint32_t maxTriangles) {
+    if (maxVertices < 3 || maxTriangles == 0) {
+        throw std::runtime_error("Failed to build meshlets, a meshlet must hold at least one triangle!");
+    }
+    MeshletMesh mesh;
+    mesh.indices.reserve(indexCount);
+    // the meshlet that last referenced each vertex, so counting distinct vertices needs no clearing
+    std::vector<uint32_t> owner(vertexCount, std::numeric_limits<uint32_t>::max());
+    Meshlet current = {0, 0, 0};
+    auto finish = [&]() {
+        if (current.indexCount == 0) {
+            return;
+        }
+        mesh.meshlets.push_back(current);
+        mesh.bounds.push_back(computeMeshletBounds(mesh.indices.data() + current.firstIndex, current.indexCount, positions, vertexCount, positionStride));
+        current = {uint32_t(mesh.indices.size()), 0, 0};
+    };
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        uint32_t id = uint32_t(mesh.meshlets.size());
+        uint32_t added = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[i + k];
+            added += owner[v] != id && (k < 1 || v != indices[i]) && (k < 2 || v != indices[i + 1]);
+        }
+        if (current.vertexCount + added > maxVertices || current.indexCount / 3 == maxTriangles) {
+            finish();
+            id = uint32_t(mesh.meshlets.size());
+        }
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[i + k];
+            if (owner[v] != id) {
+                owner[v] = id;
+                current.vertexCount++;
+            }
+            mesh.indices.push_back(v);
+        }
+        current.indexCount += 3;
+    }
+    finish();
+    return mesh;
+}
+
+} // namespace gl
@@ -0,0 +1,510 @@
+#include "mipmap_generator.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace gl {
+
+struct SrgbTables {
+    float toLinear[256];
+    // indexed by a linear value scaled to 16 bits, fine enough to round every dark value correctly
+    uint8_t fromLinear[65536];
+
+    SrgbTables() {
+        for (int i = 0; i < 256; i++) {
+            float s = i / 255.0f;
+            toLinear[i] = s <= 0.04045f ? s / 12.92f : std::pow((s + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 65536; i++) {
+            float l = i / 65535.0f;
+            float s = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            fromLinear[i] = uint8_t(std::min(std::max(s, 0.0f), 1.0f) * 255.0f + 0.5f);
+        }
+    }
+};
+
+static const SrgbTables& getSrgbTables() {
+    static const SrgbTables tables;
+    return tables;
+}
+
+// tap k of output pixel x reads source pixel 2x - 3 + k, the taps sit at +-0.25, 0.75, 1.25 and 1.75 output pixels
+static const float *getKaiserWeights() {
+    struct Weights {
+        float values[8];
+
+        Weights() {
+            const float pi = 3.14159265358979f;
+            const float alpha = 4.0f;
+            const float radius = 2.0f;
+            auto bessel0 = [](float x) {
+                float sum = 1.0f;
+                float term = 1.0f;
+                for (int i = 1; i < 16; i++) {
+                    term *= (x / (2.0f * i)) * (x / (2.0f * i));
+                    sum += term;
+                }
+                return sum;
+            };
+            float total = 0.0f;
+            for (int k = 0; k < 8; k++) {
+                float x = (k - 3.5f) / 2.0f;
+                float sinc = std::sin(pi * x) / (pi * x);
+                float t = x / radius;
+                float window = bessel0(alpha * std::sqrt(1.0f - t * t)) / bessel0(alpha);
+                values[k] = sinc * window;
+                total += values[k];
+            }
+            for (float& value : values) {
+                value /= total;
+            }
+        }
+    };
+    static const Weights weights;
+    return weights.values;
+}
+
+#ifdef OPENGL_HPP_AVX2
+
+OPENGL_HPP_TARGET_AVX2 static size_t convertAVX2(Format format, const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    size_t i = 0;
+    if (format == Format::eBGRA) {
+        const __m256i swap = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                              2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        for (; i + 8 <= pixelCount; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), _mm256_shuffle_epi8(v, swap));
+        }
+        return i;
+    }
+    const __m256i expand = format == Format::eRGB
+        ? _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)
+        : _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m256i alpha = _mm256_set1_epi32(int(0xff000000));
+    // each 16 byte load covers 4 pixels plus 4 bytes that are dropped, so stop while both loads stay in bounds
+    for (; i + 10 <= pixelCount; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3 + 12));
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(v, expand), alpha));
+    }
+    return i;
+}
+
+// 4 output pixels per iteration, rows are read without clamping so the caller keeps count at width / 2
+OPENGL_HPP_TARGET_AVX2 static uint32_t boxRowAVX2(const uint8_t *row0, const uint8_t *row1, uint8_t *out, uint32_t count) {
+    const __m256i round = _mm256_set1_epi16(2);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 0, 4, 1, 5);
+    uint32_t x = 0;
+    for (; x + 4 <= count; x += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + x * 8));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + x * 8));
+        // 16 bit channels, lo holds source pixels 0 to 3 and hi 4 to 7
+        __m256i lo = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b)));
+        __m256i hi = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(b, 1)));
+        // pairs horizontal neighbours, the lanes end up holding outputs 0, 2 and 1, 3
+        __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+        sum = _mm256_srli_epi16(_mm256_add_epi16(sum, round), 2);
+        __m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(sum, sum), order);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + x * 4), _mm256_castsi256_si128(packed));
+    }
+    return x;
+}
+
+OPENGL_HPP_TARGET_AVX2 static void kaiserRowAVX2(const float *line, uint32_t width, float *out, uint32_t outWidth, const float *weights) {
+    __m128 w[8];
+    for (int k = 0; k < 8; k++) {
+        w[k] = _mm_set1_ps(weights[k]);
+    }
+    for (uint32_t x = 0; x < outWidth; x++) {
+        __m128 acc = _mm_setzero_ps();
+        for (int k = 0; k < 8; k++) {
+            int64_t sx = std::min(std::max(int64_t(2 * x) - 3 + k, int64_t(0)), int64_t(width) - 1);
+            acc = _mm_add_ps(acc, _mm_mul_ps(w[k], _mm_loadu_ps(line + sx * 4)));
+        }
+        _mm_storeu_ps(out + size_t(x) * 4, acc);
+    }
+}
+
+OPENGL_HPP_TARGET_AVX2 static size_t kaiserColumnAVX2(const float *const *rows, const float *weights, float *out, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int k = 0; k < 8; k++) {
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(weights[k]), _mm256_loadu_ps(rows[k] + i)));
+        }
+        _mm256_storeu_ps(out + i, acc);
+    }
+    return i;
+}
+
+#endif
+
+#ifdef OPENGL_HPP_NEON
+
+static size_t convertNEON(Format format, const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    size_t i = 0;
+    if (format == Format::eBGRA) {
+        for (; i + 16 <= pixelCount; i += 16) {
+            uint8x16x4_t v = vld4q_u8(src + i * 4);
+            uint8x16_t blue = v.val[0];
+            v.val[0] = v.val[2];
+            v.val[2] = blue;
+            vst4q_u8(dst + i * 4, v);
+        }
+        return i;
+    }
+    uint8x16x4_t out;
+    out.val[3] = vdupq_n_u8(0xff);
+    for (; i + 16 <= pixelCount; i += 16) {
+        uint8x16x3_t v = vld3q_u8(src + i * 3);
+        out.val[0] = format == Format::eRGB ? v.val[0] : v.val[2];
+        out.val[1] = v.val[1];
+        out.val[2] = format == Format::eRGB ? v.val[2] : v.val[0];
+        vst4q_u8(dst + i * 4, out);
+    }
+    return i;
+}
+
+// 8 output pixels per iteration, deinterleaved loads turn the horizontal pairs into pairwise adds
+static uint32_t boxRowNEON(const uint8_t *row0, const uint8_t *row1, uint8_t *out, uint32_t count) {
+    uint32_t x = 0;
+    for (; x + 8 <= count; x += 8) {
+        uint8x16x4_t a = vld4q_u8(row0 + x * 8);
+        uint8x16x4_t b = vld4q_u8(row1 + x * 8);
+        uint8x8x4_t result;
+        result.val[0] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[0]), b.val[0]), 2);
+        result.val[1] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[1]), b.val[1]), 2);
+        result.val[2] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[2]), b.val[2]), 2);
+        result.val[3] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a.val[3]), b.val[3]), 2);
+        vst4_u8(out + x * 4, result);
+    }
+    return x;
+}
+
+static void kaiserRowNEON(const float *line, uint32_t width, float *out, uint32_t outWidth, const float *weights) {
+    for (uint32_t x = 0; x < outWidth; x++) {
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (int k = 0; k < 8; k++) {
+            int64_t sx = std::min(std::max(int64_t(2 * x) - 3 + k, int64_t(0)), int64_t(width) - 1);
+            acc = vmlaq_n_f32(acc, vld1q_f32(line + sx * 4), weights[k]);
+        }
+        vst1q_f32(out + size_t(x) * 4, acc);
+    }
+}
+
+static size_t kaiserColumnNEON(const float *const *rows, const float *weights, float *out, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (int k = 0; k < 8; k++) {
+            acc = vmlaq_n_f32(acc, vld1q_f32(rows[k] + i), weights[k]);
+        }
+        vst1q_f32(out + i, acc);
+    }
+    return i;
+}
+
+#endif
+
+static bool isConvertible(Format format) {
+    return format == Format::eRGB || format == Format::eBGR || format == Format::eBGRA || format == Format::eRGBA;
+}
+
+void convertToRGBA8(Format format, const uint8_t *src, uint8_t *dst, size_t pixelCount) {
+    if (!isConvertible(format)) {
+        throw std::runtime_error("Failed to convert pixels, unsupported format!");
+    }
+    if (format == Format::eRGBA) {
+        std::memcpy(dst, src, pixelCount * 4);
+        return;
+    }
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = convertAVX2(format, src, dst, pixelCount);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = convertNEON(format, src, dst, pixelCount);
+#endif
+    if (format == Format::eBGRA) {
+        for (; i < pixelCount; i++) {
+            dst[i * 4 + 0] = src[i * 4 + 2];
+            dst[i * 4 + 1] = src[i * 4 + 1];
+            dst[i * 4 + 2] = src[i * 4 + 0];
+            dst[i * 4 + 3] = src[i * 4 + 3];
+        }
+        return;
+    }
+    int red = format == Format::eRGB ? 0 : 2;
+    for (; i < pixelCount; i++) {
+        dst[i * 4 + 0] = src[i * 3 + red];
+        dst[i * 4 + 1] = src[i * 3 + 1];
+        dst[i * 4 + 2] = src[i * 3 + 2 - red];
+        dst[i * 4 + 3] = 0xff;
+    }
+}
+
+uint32_t getMipLevelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    for (uint32_t size = std::max(width, height); size > 1; size >>= 1) {
+        levels++;
+    }
+    return levels;
+}
+
+size_t getMipChainSize(uint32_t width, uint32_t height, uint32_t levels) {
+    size_t size = 0;
+    for (uint32_t level = 0; level < levels; level++) {
+        size += size_t(std::max(width >> level, 1u)) * std::max(height >> level, 1u) * 4;
+    }
+    return size;
+}
+
+static void downsampleBox(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst) {
+    uint32_t outWidth = std::max(width / 2, 1u);
+    uint32_t outHeight = std::max(height / 2, 1u);
+    for (uint32_t y = 0; y < outHeight; y++) {
+        const uint8_t *row0 = src + size_t(std::min(2 * y, height - 1)) * width * 4;
+        const uint8_t *row1 = src + size_t(std::min(2 * y + 1, height - 1)) * width * 4;
+        uint8_t *out = dst + size_t(y) * outWidth * 4;
+        uint32_t x = 0;
+        // the vector paths read both pixels of every pair unclamped, which holds whenever width >= 2
+        if (width >= 2) {
+#if defined(OPENGL_HPP_AVX2)
+            if (hasAVX2()) {
+                x = boxRowAVX2(row0, row1, out, outWidth);
+            }
+#elif defined(OPENGL_HPP_NEON)
+            x = boxRowNEON(row0, row1, out, outWidth);
+#endif
+        }
+        for (; x < outWidth; x++) {
+            size_t x0 = size_t(std::min(2 * x, width - 1)) * 4;
+            size_t x1 = size_t(std::min(2 * x + 1, width - 1)) * 4;
+            for (int c = 0; c < 4; c++) {
+                out[x * 4 + c] = uint8_t((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+            }
+        }
+    }
+}
+
+static void downsampleBoxSrgb(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst) {
+    const SrgbTables& tables = getSrgbTables();
+    uint32_t outWidth = std::max(width / 2, 1u);
+    uint32_t outHeight = std::max(height / 2, 1u);
+    for (uint32_t y = 0; y < outHeight; y++) {
+        const uint8_t *row0 = src + size_t(std::min(2 * y, height - 1)) * width * 4;
+        const uint8_t *row1 = src + size_t(std::min(2 * y + 1, height - 1)) * width * 4;
+        uint8_t *out = dst + size_t(y) * outWidth * 4;
+        for (uint32_t x = 0; x < outWidth; x++) {
+            size_t x0 = size_t(std::min(2 * x, width - 1)) * 4;
+            size_t x1 = size_t(std::min(2 * x + 1, width - 1)) * 4;
+            for (int c = 0; c < 3; c++) {
+                float sum = tables.toLinear[row0[x0 + c]] + tables.toLinear[row0[x1 + c]] + tables.toLinear[row1[x0 + c]] + tables.toLinear[row1[x1 + c]];
+                out[x * 4 + c] = tables.fromLinear[int(sum * (65535.0f / 4.0f) + 0.5f)];
+            }
+            out[x * 4 + 3] = uint8_t((row0[x0 + 3] + row0[x1 + 3] + row1[x0 + 3] + row1[x1 + 3] + 2) >> 2);
+        }
+    }
+}
+
+static void decodeRow(const uint8_t *src, uint32_t width, bool srgb, float *out) {
+    const SrgbTables& tables = getSrgbTables();
+    for (size_t i = 0; i < size_t(width) * 4; i++) {
+        out[i] = srgb && (i & 3) != 3 ? tables.toLinear[src[i]] : src[i] / 255.0f;
+    }
+}
+
+static void encodeRow(const float *src, uint32_t width, bool srgb, uint8_t *out) {
+    const SrgbTables& tables = getSrgbTables();
+    for (size_t i = 0; i < size_t(width) * 4; i++) {
+        // the negative lobes of the kernel can overshoot
+        float value = std::min(std::max(src[i], 0.0f), 1.0f);
+        out[i] = srgb && (i & 3) != 3 ? tables.fromLinear[int(value * 65535.0f + 0.5f)] : uint8_t(value * 255.0f + 0.5f);
+    }
+}
+
+static void kaiserRow(const float *line, uint32_t width, float *out, uint32_t outWidth, const float *weights) {
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        kaiserRowAVX2(line, width, out, outWidth, weights);
+        return;
+    }
+#elif defined(OPENGL_HPP_NEON)
+    kaiserRowNEON(line, width, out, outWidth, weights);
+    return;
+#endif
+    for (uint32_t x = 0; x < outWidth; x++) {
+        float acc[4] = {};
+        for (int k = 0; k < 8; k++) {
+            int64_t sx = std::min(std::max(int64_t(2 * x) - 3 + k, int64_t(0)), int64_t(width) - 1);
+            for (int c = 0; c < 4; c++) {
+                acc[c] += weights[k] * line[sx * 4 + c];
+            }
+        }
+        std::copy(acc, acc + 4, out + size_t(x) * 4);
+    }
+}
+
+static void downsampleKaiser(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst, bool srgb) {
+    const float *weights = getKaiserWeights();
+    uint32_t outWidth = std::max(width / 2, 1u);
+    uint32_t outHeight = std::max(height / 2, 1u);
+    size_t rowSize = size_t(outWidth) * 4;
+    std::vector<float> line(size_t(width) * 4);
+    // horizontally filtered rows keyed by source row & 7, the 8 rows one output row needs never collide
+    std::vector<float> ring(rowSize * 8);
+    int64_t ringRows[8];
+    std::fill(ringRows, ringRows + 8, int64_t(-1));
+    std::vector<float> column(rowSize);
+
+    for (uint32_t y = 0; y < outHeight; y++) {
+        const float *rows[8];
+        for (int k = 0; k < 8; k++) {
+            int64_t row = std::min(std::max(int64_t(2 * y) - 3 + k, int64_t(0)), int64_t(height) - 1);
+            float *slot = ring.data() + (row & 7) * rowSize;
+            if (ringRows[row & 7] != row) {
+                decodeRow(src + size_t(row) * width * 4, width, srgb, line.data());
+                kaiserRow(line.data(), width, slot, outWidth, weights);
+                ringRows[row & 7] = row;
+            }
+            rows[k] = slot;
+        }
+
+        size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+        if (hasAVX2()) {
+            i = kaiserColumnAVX2(rows, weights, column.data(), rowSize);
+        }
+#elif defined(OPENGL_HPP_NEON)
+        i = kaiserColumnNEON(rows, weights, column.data(), rowSize);
+#endif
+        for (; i < rowSize; i++) {
+            float acc = 0.0f;
+            for (int k = 0; k < 8; k++) {
+                acc += weights[k] * rows[k][i];
+            }
+            column[i] = acc;
+        }
+        encodeRow(column.data(), outWidth, srgb, dst + y * rowSize);
+    }
+}
+
+void downsampleRGBA8(const uint8_t *src, uint32_t width, uint32_t height, uint8_t *dst, MipFilter filter, bool srgb) {
+    if (filter == MipFilter::eKaiser) {
+        downsampleKaiser(src, width, height, dst, srgb);
+    } else if (srgb) {
+        downsampleBoxSrgb(src, width, height, dst);
+    } else {
+        downsampleBox(src, width, height, dst);
+    }
+}
+
+void generateMipChain(const uint8_t *src, uint32_t width, uint32_t height, uint32_t levels, uint8_t *dst, MipFilter filter, bool srgb) {
+    if (src != dst) {
+        std::memcpy(dst, src, size_t(width) * height * 4);
+    }
+    for (uint32_t level = 1; level < levels; level++) {
+        uint8_t *next = dst + size_t(width) * height * 4;
+        downsampleRGBA8(dst, width, height, next, filter, srgb);
+        dst = next;
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+    }
+}
+
+MipmapGenerator::MipmapGenerator(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(createInfo),
+    m_pool(createInfo.threadCount),
+    m_staging(Buffer::createBuffer(d)) {
+    m_staging.storage(m_info.stagingSize, nullptr, BufferStorage::eWrite | BufferStorage::ePersistent | BufferStorage::eCoherent, d);
+    m_mapped = static_cast<uint8_t *>(m_staging.mapRange(0, m_info.stagingSize, BufferMap::eWrite | BufferMap::ePersistent | BufferMap::eCoherent, d));
+}
+
+MipmapGenerator::~MipmapGenerator() {
+    // queued tasks still write into the mapping
+    m_pool.drain();
+    if (m_fence) {
+        m_dispatch->glDeleteSync(m_fence);
+    }
+    m_staging.unmap(*m_dispatch);
+    Buffer::deleteBuffer(m_staging, *m_dispatch);
+}
+
+Texture MipmapGenerator::add(uint32_t width, uint32_t height, Format format, const void *pixels, bool srgb) {
+    const Dispatch& d = *m_dispatch;
+    // checked here, the task runs on a worker where a throw would only surface at the next upload()
+    if (!isConvertible(format)) {
+        throw std::runtime_error("Failed to add image, unsupported format!");
+    }
+    uint32_t levels = getMipLevelCount(width, height);
+    size_t size = getMipChainSize(width, height, levels);
+    size_t offset = allocateStaging(size);
+
+    Texture texture = Texture::createTexture(TextureType::e2D, d);
+    texture.storage2D(levels, srgb ? InternalFormat::eSR8G8B8A8 : InternalFormat::eR8G8B8A8, width, height, d);
+    texture.parameter(TextureParameter::eMinFilter, static_cast<int>(Filter::eLinearMipmapLinear), d);
+    m_pending.push_back({texture, width, height, levels, offset});
+
+    uint8_t *staging = m_mapped + offset;
+    MipFilter filter = m_info.filter;
+    m_pool.submit([=]() {
+        // the chain is built in cached memory, the mapping is write combined so it is only written once, in order
+        std::vector<uint8_t> chain(size);
+        convertToRGBA8(format, static_cast<const uint8_t *>(pixels), chain.data(), size_t(width) * height);
+        generateMipChain(chain.data(), width, height, levels, chain.data(), filter, srgb);
+        std::memcpy(staging, chain.data(), size);
+    });
+    return texture;
+}
+
+void MipmapGenerator::upload() {
+    if (m_pending.empty()) {
+        return;
+    }
+    const Dispatch& d = *m_dispatch;
+    m_pool.waitIdle();
+    m_staging.bind(BufferTarget::ePixelUnpack, d);
+    for (auto& pending : m_pending) {
+        size_t offset = pending.offset;
+        for (uint32_t level = 0; level < pending.levels; level++) {
+            uint32_t width = std::max(pending.width >> level, 1u);
+            uint32_t height = std::max(pending.height >> level, 1u);
+            pending.texture.subImage2D(level, 0, 0, width, height, Format::eRGBA, Type::eUnsignedByte, reinterpret_cast<const void *>(offset), d);
+            offset += size_t(width) * height * 4;
+        }
+    }
+    Buffer::unbind(BufferTarget::ePixelUnpack, d);
+    m_pending.clear();
+    // a later fence covers every earlier copy too
+    if (m_fence) {
+        d.glDeleteSync(m_fence);
+    }
+    m_fence = d.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+size_t MipmapGenerator::allocateStaging(size_t size) {
+    if (size > m_info.stagingSize) {
+        throw std::runtime_error("Failed to add image, its mip chain is larger than the staging buffer!");
+    }
+    if (m_head + size > m_info.stagingSize) {
+        // flush what is queued and start over once every copy out of the buffer has executed
+        upload();
+        if (m_fence) {
+            m_dispatch->glClientWaitSync(m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            m_dispatch->glDeleteSync(m_fence);
+            m_fence = nullptr;
+        }
+        m_head = 0;
+    }
+    size_t offset = m_head;
+    m_head += size;
+    return offset;
+}
+
+} // namespace gl
@@ -0,0 +1,139 @@
+#include "offscreen_renderer.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <stb_image_write.h>
+
+namespace gl {
+
+std::vector<uint8_t> encodePNG(const Image& image) {
+    std::vector<uint8_t> png;
+    auto write = [](void *context, void *data, int size) {
+        auto *out = static_cast<std::vector<uint8_t> *>(context);
+        out->insert(out->end(), static_cast<uint8_t *>(data), static_cast<uint8_t *>(data) + size);
+    };
+    if (!stbi_write_png_to_func(write, &png, image.width, image.height, 4, image.pixels.data(), image.width * 4)) {
+        throw std::runtime_error("Failed to encode png!");
+    }
+    return png;
+}
+
+void writePNG(const std::string& filePath, const Image& image) {
+    std::vector<uint8_t> png = encodePNG(image);
+    std::ofstream ofs(filePath, std::ios::binary);
+    if (!ofs.is_open()) {
+        throw std::runtime_error("Failed to write file " + filePath);
+    }
+    ofs.write(reinterpret_cast<const char *>(png.data()), png.size());
+}
+
+OffscreenRenderer::OffscreenRenderer(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_width(createInfo.width),
+    m_height(createInfo.height),
+    m_encode(createInfo.encode),
+    m_framebuffer(Framebuffer::createFramebuffer(d)),
+    m_color(Renderbuffer::createRenderbuffer(d)),
+    m_encoders(createInfo.encodeThreads, createInfo.encodeQueueCapacity) {
+    m_color.storage(InternalFormat::eR8G8B8A8, m_width, m_height, d);
+    m_framebuffer.renderbuffer(FramebufferAttachment::eColor0, m_color, d);
+    if (createInfo.depth) {
+        m_depth = Renderbuffer::createRenderbuffer(d);
+        m_depth->storage(InternalFormat::eD24S8, m_width, m_height, d);
+        m_framebuffer.renderbuffer(FramebufferAttachment::eDepthStencil, *m_depth, d);
+    }
+    if (m_framebuffer.checkStatus(FramebufferTarget::eFramebuffer, d) != FramebufferStatus::eComplete) {
+        throw std::runtime_error("Offscreen framebuffer is incomplete!");
+    }
+
+    size_t size = size_t(m_width) * m_height * 4;
+    size_t slotCount = createInfo.readbackSlots ? createInfo.readbackSlots : 1;
+    for (size_t i = 0; i < slotCount; i++) {
+        Buffer buffer = Buffer::createBuffer(d);
+        // persistently mapped so retiring a slot is a plain memcpy
+        buffer.storage(size, nullptr, BufferStorage::eRead | BufferStorage::ePersistent | BufferStorage::eCoherent, d);
+        auto *mapped = static_cast<const uint8_t *>(buffer.mapRange(0, size, BufferMap::eRead | BufferMap::ePersistent | BufferMap::eCoherent, d));
+        m_slots.push_back({buffer, mapped, nullptr, 0});
+    }
+}
+
+OffscreenRenderer::~OffscreenRenderer() {
+    retireAll();
+    m_encoders.drain();
+    for (auto& slot : m_slots) {
+        slot.buffer.unmap(*m_dispatch);
+        Buffer::deleteBuffer(slot.buffer, *m_dispatch);
+    }
+    Framebuffer::deleteFramebuffer(m_framebuffer, *m_dispatch);
+    Renderbuffer::deleteRenderbuffer(m_color, *m_dispatch);
+    if (m_depth) {
+        Renderbuffer::deleteRenderbuffer(*m_depth, *m_dispatch);
+    }
+}
+
+void OffscreenRenderer::submit(uint64_t jobId, const RenderCallback& render) {
+    const Dispatch& d = *m_dispatch;
+    ReadbackSlot& slot = m_slots[m_nextSlot];
+    m_nextSlot = (m_nextSlot + 1) % m_slots.size();
+    // the slot is reused only once its previous readback has landed, this is the gpu side bound
+    retire(slot, true);
+
+    m_framebuffer.bind(FramebufferTarget::eFramebuffer, d);
+    viewport(0, 0, m_width, m_height, d);
+    render(jobId);
+
+    // queued behind the draws, the copy into the pack buffer does not stall the cpu
+    m_framebuffer.bind(FramebufferTarget::eRead, d);
+    m_framebuffer.readBuffer(FramebufferAttachment::eColor0, d);
+    slot.buffer.bind(BufferTarget::ePixelPack, d);
+    readPixels(0, 0, m_width, m_height, Format::eRGBA, Type::eUnsignedByte, nullptr, d);
+    Buffer::unbind(BufferTarget::ePixelPack, d);
+    slot.fence = d.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.jobId = jobId;
+    d.glFlush();
+
+    // opportunistically retire anything else that already finished
+    for (auto& other : m_slots) {
+        retire(other, false);
+    }
+}
+
+void OffscreenRenderer::finish() {
+    retireAll();
+    m_encoders.waitIdle();
+}
+
+void OffscreenRenderer::retireAll() {
+    // oldest first so encodes are queued in submission order
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        retire(m_slots[(m_nextSlot + i) % m_slots.size()], true);
+    }
+}
+
+void OffscreenRenderer::retire(ReadbackSlot& slot, bool wait) {
+    if (!slot.fence) {
+        return;
+    }
+    const Dispatch& d = *m_dispatch;
+    GLenum status = d.glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? GL_TIMEOUT_IGNORED : 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return;
+    }
+    d.glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    Image image{slot.jobId, m_width, m_height, std::vector<uint8_t>(size_t(m_width) * m_height * 4)};
+    // gl rows start at the bottom, flip while copying out of the mapping
+    size_t rowSize = size_t(m_width) * 4;
+    for (uint32_t y = 0; y < m_height; y++) {
+        std::memcpy(image.pixels.data() + y * rowSize, slot.mapped + (m_height - 1 - y) * rowSize, rowSize);
+    }
+    // blocks when the encoders fall behind, which is the cpu side bound
+    m_encoders.submit([this, image = std::move(image)]() mutable {
+        m_encode(std::move(image));
+    });
+}
+
+} // namespace gl
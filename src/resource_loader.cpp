@@ -0,0 +1,134 @@
+#include "resource_loader.hpp"
+
+#include <iostream>
+
+namespace gl {
+
+ResourceLoader::ResourceLoader(std::function<void()> makeContextCurrent, const Dispatch& loaderDispatch, const Dispatch& d)
+  : m_dispatch(&d),
+    m_loaderDispatch(&loaderDispatch),
+    m_errorCallback([](const std::string& log) { std::cerr << log; }),
+    m_busy(false),
+    m_stop(false),
+    m_thread(&ResourceLoader::run, this, std::move(makeContextCurrent)) {}
+
+ResourceLoader::~ResourceLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_work.clear();
+    }
+    m_workAvailable.notify_one();
+    m_thread.join();
+    update();
+}
+
+void ResourceLoader::enqueue(Work work) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_work.push_back(std::move(work));
+    }
+    m_workAvailable.notify_one();
+}
+
+void ResourceLoader::loadBuffer(std::vector<uint8_t> data, BufferStorage flags, std::function<void(Buffer)> done) {
+    enqueue([data = std::move(data), flags, done = std::move(done)](const Dispatch& d) -> std::function<void()> {
+        Buffer buffer = Buffer::createBuffer(d);
+        buffer.storage(data.size(), data.data(), flags, d);
+        return [buffer, done]() { done(buffer); };
+    });
+}
+
+void ResourceLoader::loadProgram(std::vector<ShaderSource> sources, std::function<void(Program)> done) {
+    enqueue([this, sources = std::move(sources), done = std::move(done)](const Dispatch& d) -> std::function<void()> {
+        Program program = Program::createProgram(d);
+        std::string log;
+        if (!buildProgram(sources, program, log, d)) {
+            Program::deleteProgram(program, d);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_errors.push_back(log);
+            return nullptr;
+        }
+        return [program, done]() { done(program); };
+    });
+}
+
+void ResourceLoader::update() {
+    std::deque<Finished> finished;
+    std::vector<std::string> errors;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        finished.swap(m_finished);
+        errors.swap(m_errors);
+    }
+    publish(finished);
+    for (auto& error : errors) {
+        m_errorCallback(error);
+    }
+}
+
+void ResourceLoader::finish() {
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_work.empty() && !m_busy; });
+    }
+    update();
+}
+
+void ResourceLoader::setErrorCallback(std::function<void(const std::string&)> errorCallback) {
+    m_errorCallback = std::move(errorCallback);
+}
+
+void ResourceLoader::publish(std::deque<Finished>& finished) {
+    for (auto& item : finished) {
+        // later commands on the render context wait for the upload on the gpu, the cpu carries on
+        m_dispatch->glWaitSync(item.fence, 0, GL_TIMEOUT_IGNORED);
+        m_dispatch->glDeleteSync(item.fence);
+        if (item.publish) {
+            item.publish();
+        }
+    }
+}
+
+void ResourceLoader::run(std::function<void()> makeContextCurrent) {
+    makeContextCurrent();
+    const Dispatch& d = *m_loaderDispatch;
+    while (true) {
+        Work work;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_busy = false;
+            m_idle.notify_all();
+            m_workAvailable.wait(lock, [this]() { return m_stop || !m_work.empty(); });
+            if (m_stop) {
+                return;
+            }
+            work = std::move(m_work.front());
+            m_work.pop_front();
+            m_busy = true;
+        }
+
+        std::function<void()> publish;
+        try {
+            publish = work(d);
+        } catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_errors.push_back(std::string(e.what()) + '\n');
+            continue;
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_errors.push_back("Failed to run a load job!\n");
+            continue;
+        }
+        if (!publish) {
+            continue;
+        }
+        GLsync fence = d.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        // the render context can only see the fence once it reaches the server
+        d.glFlush();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finished.push_back({fence, std::move(publish)});
+    }
+}
+
+} // namespace gl
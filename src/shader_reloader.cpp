@@ -0,0 +1,267 @@
+#include "shader_reloader.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace gl {
+
+static std::string canonicalPath(const std::string& path) {
+    return std::filesystem::weakly_canonical(path).string();
+}
+
+static std::string readSource(const std::string& path) {
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        throw std::runtime_error("Failed to read file " + path);
+    }
+    return std::string((std::istreambuf_iterator<char>(ifs)),
+                       (std::istreambuf_iterator<char>()));
+}
+
+bool buildProgram(const std::vector<ShaderSource>& sources, Program& program, std::string& log, const Dispatch& d) {
+    std::vector<Shader> shaders;
+    bool success = true;
+    try {
+        for (auto& shaderSource : sources) {
+            std::string source = readSource(shaderSource.path);
+            Shader shader = Shader::createShader(shaderSource.type, d);
+            shaders.push_back(shader);
+            shader.source(1, source.c_str(), NULL, d);
+            shader.compile(d);
+            if (!shader.getiv(ShaderIV::eCompileStatus, d)) {
+                log += shaderSource.path + ":\n" + shader.getInfoLog(d) + '\n';
+                success = false;
+            }
+        }
+    } catch (const std::exception& e) {
+        log += std::string(e.what()) + '\n';
+        success = false;
+    }
+    if (success) {
+        for (auto& shader : shaders) {
+            program.attachShader(shader, d);
+        }
+        program.link(d);
+        if (!program.getiv(ProgramIV::eLinkStatus, d)) {
+            log += program.getInfoLog(d) + '\n';
+            success = false;
+        }
+    }
+    for (auto& shader : shaders) {
+        Shader::deleteShader(shader, d);
+    }
+    return success;
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher() : m_fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+    if (m_fd == -1) {
+        throw std::runtime_error("Failed to initialise inotify!");
+    }
+}
+
+FileWatcher::~FileWatcher() {
+    close(m_fd);
+}
+
+void FileWatcher::watchDirectory(const std::string& directory) {
+    std::string path = canonicalPath(directory);
+    int wd = inotify_add_watch(m_fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd == -1) {
+        throw std::runtime_error("Failed to watch directory " + path);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_directories[wd] = path;
+}
+
+std::vector<std::string> FileWatcher::poll(int timeoutMs) {
+    std::vector<std::string> changed;
+    pollfd pfd{m_fd, POLLIN, 0};
+    if (::poll(&pfd, 1, timeoutMs) <= 0) {
+        return changed;
+    }
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(m_fd, buffer, sizeof(buffer))) > 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (char *ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + reinterpret_cast<inotify_event *>(ptr)->len) {
+            auto *event = reinterpret_cast<inotify_event *>(ptr);
+            auto directory = m_directories.find(event->wd);
+            if (event->len == 0 || directory == m_directories.end()) {
+                continue;
+            }
+            std::string path = directory->second + '/' + event->name;
+            if (std::find(changed.begin(), changed.end(), path) == changed.end()) {
+                changed.push_back(path);
+            }
+        }
+    }
+    return changed;
+}
+
+#else
+
+static long long writeTime(const std::filesystem::path& path) {
+    std::error_code ec;
+    return std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+}
+
+FileWatcher::FileWatcher() {}
+
+FileWatcher::~FileWatcher() {}
+
+void FileWatcher::watchDirectory(const std::string& directory) {
+    std::string path = canonicalPath(directory);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (std::find(m_directories.begin(), m_directories.end(), path) != m_directories.end()) {
+        return;
+    }
+    m_directories.push_back(path);
+    for (auto& entry : std::filesystem::directory_iterator(path)) {
+        m_writeTimes[entry.path().string()] = writeTime(entry.path());
+    }
+}
+
+std::vector<std::string> FileWatcher::poll(int timeoutMs) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+    std::vector<std::string> changed;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& directory : m_directories) {
+        std::error_code ec;
+        for (auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+            std::string path = entry.path().string();
+            long long time = writeTime(entry.path());
+            auto itr = m_writeTimes.find(path);
+            if (itr == m_writeTimes.end() || itr->second != time) {
+                m_writeTimes[path] = time;
+                changed.push_back(path);
+            }
+        }
+    }
+    return changed;
+}
+
+#endif
+
+ShaderReloader::ShaderReloader(std::function<void()> makeContextCurrent, const Dispatch& d)
+  : m_dispatch(&d),
+    m_errorCallback([](const std::string& log) { std::cerr << log; }),
+    m_stop(false),
+    m_thread(&ShaderReloader::run, this, std::move(makeContextCurrent)) {}
+
+ShaderReloader::~ShaderReloader() {
+    m_stop = true;
+    m_thread.join();
+    for (auto& pending : m_pending) {
+        m_dispatch->glDeleteSync(pending.fence);
+        Program::deleteProgram(pending.program, *m_dispatch);
+    }
+    for (auto& program : m_programs) {
+        Program::deleteProgram(program, *m_dispatch);
+    }
+}
+
+ShaderReloader::Handle ShaderReloader::addProgram(const std::vector<ShaderSource>& sources) {
+    std::vector<ShaderSource> canonicalSources;
+    for (auto& shaderSource : sources) {
+        canonicalSources.push_back({shaderSource.type, canonicalPath(shaderSource.path)});
+        m_watcher.watchDirectory(std::filesystem::path(canonicalSources.back().path).parent_path().string());
+    }
+
+    Program program = Program::createProgram(*m_dispatch);
+    std::string log;
+    if (!buildProgram(canonicalSources, program, log, *m_dispatch)) {
+        m_errorCallback(log);
+    }
+    m_programs.push_back(program);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sources.push_back(std::move(canonicalSources));
+    return m_sources.size() - 1;
+}
+
+Program ShaderReloader::getProgram(Handle handle) {
+    return m_programs[handle];
+}
+
+void ShaderReloader::update() {
+    std::vector<std::string> errors;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        errors.swap(m_errors);
+        auto itr = m_pending.begin();
+        while (itr != m_pending.end()) {
+            GLenum status = m_dispatch->glClientWaitSync(itr->fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                ++itr;
+                continue;
+            }
+            m_dispatch->glDeleteSync(itr->fence);
+            Program::deleteProgram(m_programs[itr->handle], *m_dispatch);
+            m_programs[itr->handle] = itr->program;
+            itr = m_pending.erase(itr);
+        }
+    }
+    for (auto& error : errors) {
+        m_errorCallback(error);
+    }
+}
+
+void ShaderReloader::setErrorCallback(std::function<void(const std::string&)> errorCallback) {
+    m_errorCallback = std::move(errorCallback);
+}
+
+void ShaderReloader::run(std::function<void()> makeContextCurrent) {
+    makeContextCurrent();
+    while (!m_stop) {
+        std::vector<std::string> changed = m_watcher.poll(100);
+        if (changed.empty()) {
+            continue;
+        }
+        // editors tend to save in several steps, wait for the burst to settle
+        for (auto more = m_watcher.poll(20); !more.empty(); more = m_watcher.poll(20)) {
+            changed.insert(changed.end(), more.begin(), more.end());
+        }
+
+        std::vector<std::pair<Handle, std::vector<ShaderSource>>> affected;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (Handle handle = 0; handle < m_sources.size(); handle++) {
+                for (auto& shaderSource : m_sources[handle]) {
+                    if (std::find(changed.begin(), changed.end(), shaderSource.path) != changed.end()) {
+                        affected.emplace_back(handle, m_sources[handle]);
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (auto& [handle, sources] : affected) {
+            Program program = Program::createProgram(*m_dispatch);
+            std::string log;
+            if (buildProgram(sources, program, log, *m_dispatch)) {
+                GLsync fence = m_dispatch->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                // the render context can only see the fence once it reaches the server
+                m_dispatch->glFlush();
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending.push_back({handle, program, fence});
+            } else {
+                Program::deleteProgram(program, *m_dispatch);
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_errors.push_back(log);
+            }
+        }
+    }
+}
+
+} // namespace gl
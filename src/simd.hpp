@@ -0,0 +1,35 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+// vector instruction set used by the cpu side helpers in src, kept out of the public headers
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define OPENGL_HPP_AVX2
+// built for avx2 whatever the target flags are, only called after hasAVX2(), every avx2 cpu also has f16c
+#define OPENGL_HPP_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#elif defined(_MSC_VER) && defined(__AVX2__)
+#include <immintrin.h>
+#define OPENGL_HPP_AVX2
+#define OPENGL_HPP_TARGET_AVX2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define OPENGL_HPP_NEON
+#endif
+
+namespace gl {
+
+#ifdef OPENGL_HPP_AVX2
+inline bool hasAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return true;
+#endif
+}
+#endif
+
+} // namespace gl
+
+#endif
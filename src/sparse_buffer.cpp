@@ -0,0 +1,149 @@
+#include "sparse_buffer.hpp"
+
+#include <numeric>
+#include <stdexcept>
+
+namespace gl {
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+SparseBuffer::SparseBuffer(size_t virtualSize, BufferStorage flags, const Dispatch& d)
+  : m_dispatch(&d),
+    m_buffer(Buffer::createBuffer(d)),
+    m_committedPages(0) {
+    if (!isExtensionSupported("GL_ARB_sparse_buffer", d)) {
+        Buffer::deleteBuffer(m_buffer, d);
+        throw std::runtime_error("Failed to create SparseBuffer, ARB_sparse_buffer is not supported!");
+    }
+    GLint pageSize = 0;
+    d.glGetIntegerv(GL_SPARSE_BUFFER_PAGE_SIZE_ARB, &pageSize);
+    m_pageSize = pageSize;
+    m_virtualSize = alignUp(virtualSize, m_pageSize);
+    m_buffer.storage(m_virtualSize, nullptr, flags | BufferStorage::eSparse, d);
+    m_free[0] = m_virtualSize;
+    m_pageReferences.resize(m_virtualSize / m_pageSize, 0);
+}
+
+SparseBuffer::~SparseBuffer() {
+    Buffer::deleteBuffer(m_buffer, *m_dispatch);
+}
+
+size_t SparseBuffer::allocate(size_t size, size_t alignment) {
+    if (size == 0 || alignment == 0) {
+        throw std::runtime_error("Failed to allocate from SparseBuffer, the size and alignment must not be zero!");
+    }
+    if (size >= m_pageSize) {
+        // satisfies both, a page size that is not a multiple of the alignment still gets an aligned offset
+        alignment = std::lcm(m_pageSize, alignment);
+    }
+    // best fit keeps large free blocks intact for large allocations
+    auto best = m_free.end();
+    size_t bestOffset = 0;
+    for (auto itr = m_free.begin(); itr != m_free.end(); ++itr) {
+        size_t offset = alignUp(itr->first, alignment);
+        size_t end = itr->first + itr->second;
+        if (offset > end || size > end - offset) {
+            continue;
+        }
+        if (best == m_free.end() || itr->second < best->second) {
+            best = itr;
+            bestOffset = offset;
+        }
+    }
+    if (best == m_free.end()) {
+        throw std::runtime_error("Failed to allocate from SparseBuffer, the virtual range is exhausted!");
+    }
+
+    size_t blockOffset = best->first;
+    size_t blockEnd = best->first + best->second;
+    m_free.erase(best);
+    if (bestOffset > blockOffset) {
+        m_free[blockOffset] = bestOffset - blockOffset;
+    }
+    if (bestOffset + size < blockEnd) {
+        m_free[bestOffset + size] = blockEnd - (bestOffset + size);
+    }
+    m_allocations[bestOffset] = size;
+    referencePages(bestOffset, size, true);
+    return bestOffset;
+}
+
+void SparseBuffer::free(size_t offset) {
+    auto allocation = m_allocations.find(offset);
+    if (allocation == m_allocations.end()) {
+        throw std::runtime_error("Failed to free SparseBuffer allocation, unknown offset!");
+    }
+    size_t size = allocation->second;
+    m_allocations.erase(allocation);
+    referencePages(offset, size, false);
+
+    auto next = m_free.lower_bound(offset);
+    if (next != m_free.end() && next->first == offset + size) {
+        size += next->second;
+        next = m_free.erase(next);
+    }
+    if (next != m_free.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+    m_free[offset] = size;
+}
+
+Buffer SparseBuffer::getBuffer() const {
+    return m_buffer;
+}
+
+size_t SparseBuffer::getPageSize() const {
+    return m_pageSize;
+}
+
+size_t SparseBuffer::getVirtualSize() const {
+    return m_virtualSize;
+}
+
+size_t SparseBuffer::getCommittedSize() const {
+    return m_committedPages * m_pageSize;
+}
+
+void SparseBuffer::referencePages(size_t offset, size_t size, bool reference) {
+    if (size == 0) {
+        return;
+    }
+    size_t firstPage = offset / m_pageSize;
+    size_t lastPage = (offset + size - 1) / m_pageSize;
+    // batch neighbouring pages that change state into a single commitment call
+    size_t runStart = 0;
+    size_t runLength = 0;
+    for (size_t page = firstPage; page <= lastPage; page++) {
+        uint32_t& count = m_pageReferences[page];
+        bool changes = reference ? count++ == 0 : --count == 0;
+        if (changes) {
+            if (runLength == 0) {
+                runStart = page;
+            }
+            runLength++;
+        } else if (runLength) {
+            commitRun(runStart, runLength, reference);
+            runLength = 0;
+        }
+    }
+    if (runLength) {
+        commitRun(runStart, runLength, reference);
+    }
+}
+
+void SparseBuffer::commitRun(size_t firstPage, size_t pageCount, bool commit) {
+    m_buffer.pageCommitment(firstPage * m_pageSize, pageCount * m_pageSize, commit, *m_dispatch);
+    if (commit) {
+        m_committedPages += pageCount;
+    } else {
+        m_committedPages -= pageCount;
+    }
+}
+
+} // namespace gl
@@ -0,0 +1,239 @@
+#include "texture_atlas.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace gl {
+
+TextureAtlas::TextureAtlas(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(createInfo),
+    m_texture(Texture::createTexture(TextureType::e2DArray, d)),
+    m_staging(Buffer::createBuffer(d)) {
+    m_texture.storage3D(1, m_info.internalFormat, m_info.width, m_info.height, m_info.layers, d);
+    m_texture.parameter(TextureParameter::eMinFilter, static_cast<int>(Filter::eLinear), d);
+    m_texture.parameter(TextureParameter::eMagFilter, static_cast<int>(Filter::eLinear), d);
+    m_texture.parameter(TextureParameter::eWrapS, static_cast<int>(Wrap::eClampToEdge), d);
+    m_texture.parameter(TextureParameter::eWrapT, static_cast<int>(Wrap::eClampToEdge), d);
+    m_skylines.resize(m_info.layers, {{0, 0, m_info.width}});
+
+    m_staging.storage(m_info.stagingSize, nullptr, BufferStorage::eWrite | BufferStorage::ePersistent | BufferStorage::eCoherent, d);
+    m_mapped = static_cast<uint8_t *>(m_staging.mapRange(0, m_info.stagingSize, BufferMap::eWrite | BufferMap::ePersistent | BufferMap::eCoherent, d));
+}
+
+TextureAtlas::~TextureAtlas() {
+    for (auto& segment : m_segments) {
+        m_dispatch->glDeleteSync(segment.fence);
+    }
+    m_staging.unmap(*m_dispatch);
+    Buffer::deleteBuffer(m_staging, *m_dispatch);
+    Texture::deleteTexture(m_texture, *m_dispatch);
+}
+
+AtlasRegion TextureAtlas::add(uint32_t width, uint32_t height, const void *pixels) {
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("Failed to add image, its size must not be zero!");
+    }
+    uint32_t paddedWidth = width + 2 * m_info.padding;
+    uint32_t paddedHeight = height + 2 * m_info.padding;
+
+    // best node per layer is the one leaving the lowest top edge, ties go to the leftmost
+    uint32_t bestLayer = 0;
+    size_t bestNode = 0;
+    uint32_t bestY = 0;
+    uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+    for (uint32_t layer = 0; layer < m_info.layers && bestTop == std::numeric_limits<uint32_t>::max(); layer++) {
+        const std::vector<SkylineNode>& skyline = m_skylines[layer];
+        for (size_t node = 0; node < skyline.size(); node++) {
+            uint32_t y;
+            if (fit(skyline, node, paddedWidth, paddedHeight, y) && y + paddedHeight < bestTop) {
+                bestLayer = layer;
+                bestNode = node;
+                bestY = y;
+                bestTop = y + paddedHeight;
+            }
+        }
+    }
+    if (bestTop == std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Failed to add image, the atlas is full!");
+    }
+    uint32_t x = m_skylines[bestLayer][bestNode].x;
+    place(m_skylines[bestLayer], bestNode, x, bestY, paddedWidth, paddedHeight);
+    m_usedArea += uint64_t(paddedWidth) * paddedHeight;
+
+    size_t size = rowPitch(paddedWidth) * paddedHeight;
+    if (size <= m_info.stagingSize) {
+        size_t offset = allocateStaging(size);
+        extrude(m_mapped + offset, width, height, static_cast<const uint8_t *>(pixels));
+        m_pending.push_back({bestLayer, x, bestY, paddedWidth, paddedHeight, offset});
+    } else {
+        std::vector<uint8_t> padded(size);
+        extrude(padded.data(), width, height, static_cast<const uint8_t *>(pixels));
+        m_texture.subImage3D(0, x, bestY, bestLayer, paddedWidth, paddedHeight, 1, m_info.format, m_info.type, padded.data(), *m_dispatch);
+    }
+
+    AtlasRegion region;
+    region.layer = bestLayer;
+    region.x = x + m_info.padding;
+    region.y = bestY + m_info.padding;
+    region.width = width;
+    region.height = height;
+    region.u0 = float(region.x) / m_info.width;
+    region.v0 = float(region.y) / m_info.height;
+    region.u1 = float(region.x + width) / m_info.width;
+    region.v1 = float(region.y + height) / m_info.height;
+    return region;
+}
+
+void TextureAtlas::upload() {
+    if (m_pending.empty()) {
+        return;
+    }
+    const Dispatch& d = *m_dispatch;
+    m_staging.bind(BufferTarget::ePixelUnpack, d);
+    for (auto& pending : m_pending) {
+        m_texture.subImage3D(0, pending.x, pending.y, pending.layer, pending.width, pending.height, 1, m_info.format, m_info.type,
+                             reinterpret_cast<const void *>(pending.offset), d);
+    }
+    Buffer::unbind(BufferTarget::ePixelUnpack, d);
+    m_pending.clear();
+    // the staging bytes written so far may be reused once the copies above have executed
+    m_segments.push_back({d.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_head});
+}
+
+void TextureAtlas::clear() {
+    upload();
+    for (auto& skyline : m_skylines) {
+        skyline.assign(1, {0, 0, m_info.width});
+    }
+    m_usedArea = 0;
+}
+
+void TextureAtlas::bind(uint32_t unit) {
+    m_texture.bindUnit(unit, *m_dispatch);
+}
+
+Texture TextureAtlas::getTexture() const {
+    return m_texture;
+}
+
+float TextureAtlas::getOccupancy() const {
+    return float(double(m_usedArea) / (double(m_info.width) * m_info.height * m_info.layers));
+}
+
+bool TextureAtlas::fit(const std::vector<SkylineNode>& skyline, size_t node, uint32_t width, uint32_t height, uint32_t& y) const {
+    uint32_t x = skyline[node].x;
+    if (x + width > m_info.width) {
+        return false;
+    }
+    // the image rests on the highest segment below its span
+    y = 0;
+    int64_t widthLeft = width;
+    for (size_t i = node; widthLeft > 0; i++) {
+        y = std::max(y, skyline[i].y);
+        if (y + height > m_info.height) {
+            return false;
+        }
+        widthLeft -= skyline[i].width;
+    }
+    return true;
+}
+
+void TextureAtlas::place(std::vector<SkylineNode>& skyline, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    skyline.insert(skyline.begin() + node, {x, y + height, width});
+    // trim or drop the segments now covered by the new one
+    for (size_t i = node + 1; i < skyline.size();) {
+        uint32_t previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= previousEnd) {
+            break;
+        }
+        uint32_t shrink = previousEnd - skyline[i].x;
+        if (skyline[i].width <= shrink) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        break;
+    }
+    // neighbours at the same height become one segment
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+}
+
+void TextureAtlas::extrude(uint8_t *dst, uint32_t width, uint32_t height, const uint8_t *pixels) const {
+    uint32_t padding = m_info.padding;
+    uint32_t texelSize = m_info.texelSize;
+    size_t pitch = rowPitch(width + 2 * padding);
+    size_t srcPitch = size_t(width) * texelSize;
+    for (uint32_t row = 0; row < height + 2 * padding; row++) {
+        uint32_t srcRow = std::min(row > padding ? row - padding : 0, height - 1);
+        const uint8_t *src = pixels + srcRow * srcPitch;
+        uint8_t *out = dst + row * pitch;
+        for (uint32_t i = 0; i < padding; i++) {
+            std::memcpy(out + i * texelSize, src, texelSize);
+            std::memcpy(out + (padding + width + i) * texelSize, src + srcPitch - texelSize, texelSize);
+        }
+        std::memcpy(out + padding * texelSize, src, srcPitch);
+    }
+}
+
+size_t TextureAtlas::rowPitch(uint32_t width) const {
+    // GL_UNPACK_ALIGNMENT defaults to 4
+    return (size_t(width) * m_info.texelSize + 3) & ~size_t(3);
+}
+
+size_t TextureAtlas::allocateStaging(size_t size) {
+    while (true) {
+        retireStaging(false);
+        if (m_segments.empty() && m_pending.empty()) {
+            m_head = 0;
+            m_tail = 0;
+        }
+        bool empty = m_segments.empty() && m_pending.empty();
+        if (m_head >= m_tail) {
+            if (m_info.stagingSize - m_head >= size) {
+                size_t offset = m_head;
+                m_head += size;
+                return offset;
+            }
+            // wrap around, keeping head short of tail so a full ring is not mistaken for an empty one
+            if (size < m_tail || (empty && size <= m_info.stagingSize)) {
+                m_head = size;
+                return 0;
+            }
+        } else if (m_tail - m_head > size) {
+            size_t offset = m_head;
+            m_head += size;
+            return offset;
+        }
+        // out of room, push what is pending so its bytes can be reclaimed, then wait for the oldest copies
+        if (!m_pending.empty()) {
+            upload();
+        }
+        retireStaging(true);
+    }
+}
+
+void TextureAtlas::retireStaging(bool wait) {
+    while (!m_segments.empty()) {
+        GLenum status = m_dispatch->glClientWaitSync(m_segments.front().fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? GL_TIMEOUT_IGNORED : 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            return;
+        }
+        m_dispatch->glDeleteSync(m_segments.front().fence);
+        m_tail = m_segments.front().end;
+        m_segments.pop_front();
+        wait = false;
+    }
+}
+
+} // namespace gl
@@ -0,0 +1,355 @@
+#include "texture_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace gl {
+
+static const uint8_t ktx2Identifier[12] = {0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n'};
+
+template <typename T>
+static T read(const uint8_t *data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+static constexpr uint32_t fourCC(char a, char b, char c, char d) {
+    return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 | uint32_t(uint8_t(d)) << 24;
+}
+
+// VkFormat values used by KTX2, the BCn, ETC2/EAC and ASTC ranges are contiguous (131 to 184)
+static bool formatFromVulkan(uint32_t vkFormat, InternalFormat& format) {
+    static const InternalFormat formats[] = {
+        InternalFormat::eBC1RGB, InternalFormat::eBC1SRGB, InternalFormat::eBC1RGBA, InternalFormat::eBC1SRGBA,
+        InternalFormat::eBC2, InternalFormat::eBC2SRGB, InternalFormat::eBC3, InternalFormat::eBC3SRGB,
+        InternalFormat::eBC4, InternalFormat::eBC4snorm, InternalFormat::eBC5, InternalFormat::eBC5snorm,
+        InternalFormat::eBC6HUFloat, InternalFormat::eBC6HSFloat, InternalFormat::eBC7, InternalFormat::eBC7SRGB,
+        InternalFormat::eETC2RGB8, InternalFormat::eETC2SRGB8, InternalFormat::eETC2RGB8A1, InternalFormat::eETC2SRGB8A1,
+        InternalFormat::eETC2RGBA8, InternalFormat::eETC2SRGBA8,
+        InternalFormat::eEACR11, InternalFormat::eEACR11snorm, InternalFormat::eEACRG11, InternalFormat::eEACRG11snorm,
+        InternalFormat::eASTC4x4, InternalFormat::eASTC4x4SRGB, InternalFormat::eASTC5x4, InternalFormat::eASTC5x4SRGB,
+        InternalFormat::eASTC5x5, InternalFormat::eASTC5x5SRGB, InternalFormat::eASTC6x5, InternalFormat::eASTC6x5SRGB,
+        InternalFormat::eASTC6x6, InternalFormat::eASTC6x6SRGB, InternalFormat::eASTC8x5, InternalFormat::eASTC8x5SRGB,
+        InternalFormat::eASTC8x6, InternalFormat::eASTC8x6SRGB, InternalFormat::eASTC8x8, InternalFormat::eASTC8x8SRGB,
+        InternalFormat::eASTC10x5, InternalFormat::eASTC10x5SRGB, InternalFormat::eASTC10x6, InternalFormat::eASTC10x6SRGB,
+        InternalFormat::eASTC10x8, InternalFormat::eASTC10x8SRGB, InternalFormat::eASTC10x10, InternalFormat::eASTC10x10SRGB,
+        InternalFormat::eASTC12x10, InternalFormat::eASTC12x10SRGB, InternalFormat::eASTC12x12, InternalFormat::eASTC12x12SRGB,
+    };
+    if (vkFormat < 131 || vkFormat >= 131 + sizeof(formats) / sizeof(formats[0])) {
+        return false;
+    }
+    format = formats[vkFormat - 131];
+    return true;
+}
+
+static bool formatFromDXGI(uint32_t dxgiFormat, InternalFormat& format) {
+    switch (dxgiFormat) {
+        case 71: format = InternalFormat::eBC1RGBA; return true;
+        case 72: format = InternalFormat::eBC1SRGBA; return true;
+        case 74: format = InternalFormat::eBC2; return true;
+        case 75: format = InternalFormat::eBC2SRGB; return true;
+        case 77: format = InternalFormat::eBC3; return true;
+        case 78: format = InternalFormat::eBC3SRGB; return true;
+        case 80: format = InternalFormat::eBC4; return true;
+        case 81: format = InternalFormat::eBC4snorm; return true;
+        case 83: format = InternalFormat::eBC5; return true;
+        case 84: format = InternalFormat::eBC5snorm; return true;
+        case 95: format = InternalFormat::eBC6HUFloat; return true;
+        case 96: format = InternalFormat::eBC6HSFloat; return true;
+        case 98: format = InternalFormat::eBC7; return true;
+        case 99: format = InternalFormat::eBC7SRGB; return true;
+    }
+    return false;
+}
+
+static bool formatFromFourCC(uint32_t code, InternalFormat& format) {
+    switch (code) {
+        case fourCC('D', 'X', 'T', '1'): format = InternalFormat::eBC1RGBA; return true;
+        case fourCC('D', 'X', 'T', '2'):
+        case fourCC('D', 'X', 'T', '3'): format = InternalFormat::eBC2; return true;
+        case fourCC('D', 'X', 'T', '4'):
+        case fourCC('D', 'X', 'T', '5'): format = InternalFormat::eBC3; return true;
+        case fourCC('A', 'T', 'I', '1'):
+        case fourCC('B', 'C', '4', 'U'): format = InternalFormat::eBC4; return true;
+        case fourCC('B', 'C', '4', 'S'): format = InternalFormat::eBC4snorm; return true;
+        case fourCC('A', 'T', 'I', '2'):
+        case fourCC('B', 'C', '5', 'U'): format = InternalFormat::eBC5; return true;
+        case fourCC('B', 'C', '5', 'S'): format = InternalFormat::eBC5snorm; return true;
+    }
+    return false;
+}
+
+// rejects headers whose sizes would overflow levelSize or the layer count before any region is built
+static void checkDimensions(uint32_t width, uint32_t height, uint32_t levels, uint32_t layers, uint32_t faces, const std::string& container) {
+    if (width == 0 || height == 0) {
+        throw std::runtime_error("Failed to load " + container + " file, the size must not be zero!");
+    }
+    // past what any gl implementation accepts, and keeps levelSize well inside size_t
+    if (width > 65536 || height > 65536) {
+        throw std::runtime_error("Failed to load " + container + " file, the size is too large!");
+    }
+    uint32_t maxLevels = 1;
+    while (std::max(width, height) >> maxLevels) {
+        maxLevels++;
+    }
+    if (levels > maxLevels) {
+        throw std::runtime_error("Failed to load " + container + " file, it has more levels than a full mip chain!");
+    }
+    if (layers > UINT32_MAX / faces) {
+        throw std::runtime_error("Failed to load " + container + " file, the layer count overflows!");
+    }
+}
+
+bool getCompressedBlockInfo(InternalFormat format, CompressedBlockInfo& blockInfo) {
+    switch (format) {
+        case InternalFormat::eBC1RGB:
+        case InternalFormat::eBC1RGBA:
+        case InternalFormat::eBC1SRGB:
+        case InternalFormat::eBC1SRGBA:
+        case InternalFormat::eBC4:
+        case InternalFormat::eBC4snorm:
+        case InternalFormat::eETC2RGB8:
+        case InternalFormat::eETC2SRGB8:
+        case InternalFormat::eETC2RGB8A1:
+        case InternalFormat::eETC2SRGB8A1:
+        case InternalFormat::eEACR11:
+        case InternalFormat::eEACR11snorm:
+            blockInfo = {4, 4, 8};
+            return true;
+        case InternalFormat::eBC2:
+        case InternalFormat::eBC2SRGB:
+        case InternalFormat::eBC3:
+        case InternalFormat::eBC3SRGB:
+        case InternalFormat::eBC5:
+        case InternalFormat::eBC5snorm:
+        case InternalFormat::eBC6HUFloat:
+        case InternalFormat::eBC6HSFloat:
+        case InternalFormat::eBC7:
+        case InternalFormat::eBC7SRGB:
+        case InternalFormat::eETC2RGBA8:
+        case InternalFormat::eETC2SRGBA8:
+        case InternalFormat::eEACRG11:
+        case InternalFormat::eEACRG11snorm:
+            blockInfo = {4, 4, 16};
+            return true;
+        default:
+            break;
+    }
+    // every astc block is 16 bytes, the footprint follows the token order
+    static const uint8_t astcFootprints[][2] = {
+        {4, 4}, {5, 4}, {5, 5}, {6, 5}, {6, 6}, {8, 5}, {8, 6}, {8, 8}, {10, 5}, {10, 6}, {10, 8}, {10, 10}, {12, 10}, {12, 12},
+    };
+    GLenum value = static_cast<GLenum>(format);
+    for (GLenum base : {GLenum(GL_COMPRESSED_RGBA_ASTC_4x4_KHR), GLenum(GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR)}) {
+        if (value >= base && value < base + 14) {
+            blockInfo = {astcFootprints[value - base][0], astcFootprints[value - base][1], 16};
+            return true;
+        }
+    }
+    return false;
+}
+
+TextureFile::TextureFile(MappedFile file) : m_file(file) {}
+
+TextureFile TextureFile::loadFile(const char *filePath) {
+    TextureFile textureFile(MappedFile::mapFile(filePath));
+    try {
+        const uint8_t *data = static_cast<const uint8_t *>(textureFile.m_file.data());
+        size_t size = textureFile.m_file.size();
+        if (size >= sizeof(ktx2Identifier) && std::memcmp(data, ktx2Identifier, sizeof(ktx2Identifier)) == 0) {
+            textureFile.parseKTX2();
+        } else if (size >= 4 && read<uint32_t>(data, 0) == fourCC('D', 'D', 'S', ' ')) {
+            textureFile.parseDDS();
+        } else {
+            throw std::runtime_error("Failed to load texture file, unknown container!");
+        }
+        for (auto& region : textureFile.m_regions) {
+            if (region.offset > size || region.size > size - region.offset) {
+                throw std::runtime_error("Failed to load texture file, it is truncated!");
+            }
+        }
+    } catch (...) {
+        MappedFile::unmapFile(textureFile.m_file);
+        throw;
+    }
+    return textureFile;
+}
+
+void TextureFile::unloadFile(TextureFile& textureFile) {
+    MappedFile::unmapFile(textureFile.m_file);
+    textureFile.m_regions.clear();
+}
+
+Texture TextureFile::createTexture(const Dispatch& d) const {
+    TextureType type = getType();
+    Texture texture = Texture::createTexture(type, d);
+    if (type == TextureType::e2D || type == TextureType::eCubeMap) {
+        texture.storage2D(m_levels, m_internalFormat, m_width, m_height, d);
+    } else {
+        texture.storage3D(m_levels, m_internalFormat, m_width, m_height, m_layers * m_faces, d);
+    }
+    texture.parameter(TextureParameter::eMinFilter, static_cast<int>(m_levels > 1 ? Filter::eLinearMipmapLinear : Filter::eLinear), d);
+    texture.parameter(TextureParameter::eMaxLevel, m_levels - 1, d);
+
+    // one unpack buffer filled straight from the mapping covers every region
+    size_t first = m_regions.front().offset;
+    size_t last = first;
+    for (auto& region : m_regions) {
+        first = std::min(first, region.offset);
+        last = std::max(last, region.offset + region.size);
+    }
+    Buffer staging = Buffer::createBuffer(d);
+    staging.storage(last - first, static_cast<const uint8_t *>(m_file.data()) + first, BufferStorage::eNone, d);
+    staging.bind(BufferTarget::ePixelUnpack, d);
+    for (auto& region : m_regions) {
+        uint32_t width = std::max(m_width >> region.level, 1u);
+        uint32_t height = std::max(m_height >> region.level, 1u);
+        const void *offset = reinterpret_cast<const void *>(region.offset - first);
+        if (type == TextureType::e2D) {
+            texture.compressedSubImage2D(region.level, 0, 0, width, height, m_internalFormat, region.size, offset, d);
+        } else {
+            texture.compressedSubImage3D(region.level, 0, 0, region.layer, width, height, region.layerCount, m_internalFormat, region.size, offset, d);
+        }
+    }
+    Buffer::unbind(BufferTarget::ePixelUnpack, d);
+    // the copies above keep the storage alive until they have executed
+    Buffer::deleteBuffer(staging, d);
+    return texture;
+}
+
+TextureType TextureFile::getType() const {
+    if (m_faces == 6) {
+        return m_layers > 1 ? TextureType::eCubeMapArray : TextureType::eCubeMap;
+    }
+    return m_layers > 1 ? TextureType::e2DArray : TextureType::e2D;
+}
+
+InternalFormat TextureFile::getInternalFormat() const {
+    return m_internalFormat;
+}
+
+uint32_t TextureFile::getWidth() const {
+    return m_width;
+}
+
+uint32_t TextureFile::getHeight() const {
+    return m_height;
+}
+
+uint32_t TextureFile::getLevelCount() const {
+    return m_levels;
+}
+
+uint32_t TextureFile::getLayerCount() const {
+    return m_layers;
+}
+
+uint32_t TextureFile::getFaceCount() const {
+    return m_faces;
+}
+
+void TextureFile::parseKTX2() {
+    const uint8_t *data = static_cast<const uint8_t *>(m_file.data());
+    size_t size = m_file.size();
+    if (size < 80) {
+        throw std::runtime_error("Failed to load KTX2 file, the header is truncated!");
+    }
+    uint32_t vkFormat = read<uint32_t>(data, 12);
+    m_width = read<uint32_t>(data, 20);
+    // a height of zero marks a 1d texture, loaded as a single row
+    m_height = std::max(read<uint32_t>(data, 24), 1u);
+    uint32_t depth = read<uint32_t>(data, 28);
+    m_layers = std::max(read<uint32_t>(data, 32), 1u);
+    m_faces = read<uint32_t>(data, 36);
+    // zero asks the loader to generate mips, only the base level is stored
+    m_levels = std::max(read<uint32_t>(data, 40), 1u);
+    uint32_t supercompression = read<uint32_t>(data, 44);
+    if (!formatFromVulkan(vkFormat, m_internalFormat)) {
+        throw std::runtime_error("Failed to load KTX2 file, the format is not block compressed!");
+    }
+    if (supercompression != 0) {
+        throw std::runtime_error("Failed to load KTX2 file, supercompression is not supported!");
+    }
+    if (depth > 1 || (m_faces != 1 && m_faces != 6)) {
+        throw std::runtime_error("Failed to load KTX2 file, 3d textures are not supported!");
+    }
+    checkDimensions(m_width, m_height, m_levels, m_layers, m_faces, "KTX2");
+    if (size < 80 + size_t(m_levels) * 24) {
+        throw std::runtime_error("Failed to load KTX2 file, the level index is truncated!");
+    }
+    // each level holds every layer and face back to back, which is also the order gl numbers them in
+    for (uint32_t level = 0; level < m_levels; level++) {
+        uint64_t offset = read<uint64_t>(data, 80 + level * 24);
+        uint64_t length = read<uint64_t>(data, 80 + level * 24 + 8);
+        size_t layerCount = size_t(m_layers) * m_faces;
+        if (levelSize(level) > size / layerCount || length != levelSize(level) * layerCount) {
+            throw std::runtime_error("Failed to load KTX2 file, unexpected level size!");
+        }
+        m_regions.push_back({level, 0, m_layers * m_faces, size_t(offset), size_t(length)});
+    }
+}
+
+void TextureFile::parseDDS() {
+    const uint8_t *data = static_cast<const uint8_t *>(m_file.data());
+    size_t size = m_file.size();
+    if (size < 128 || read<uint32_t>(data, 4) != 124) {
+        throw std::runtime_error("Failed to load DDS file, the header is truncated!");
+    }
+    m_height = read<uint32_t>(data, 12);
+    m_width = read<uint32_t>(data, 16);
+    m_levels = std::max(read<uint32_t>(data, 28), 1u);
+    uint32_t pixelFormatFlags = read<uint32_t>(data, 80);
+    uint32_t code = read<uint32_t>(data, 84);
+    uint32_t caps2 = read<uint32_t>(data, 112);
+    m_layers = 1;
+    m_faces = (caps2 & 0x200) ? 6 : 1;
+    size_t dataOffset = 128;
+    // DDPF_FOURCC
+    if (!(pixelFormatFlags & 0x4)) {
+        throw std::runtime_error("Failed to load DDS file, the format is not block compressed!");
+    }
+    if (code == fourCC('D', 'X', '1', '0')) {
+        if (size < 148) {
+            throw std::runtime_error("Failed to load DDS file, the header is truncated!");
+        }
+        if (!formatFromDXGI(read<uint32_t>(data, 128), m_internalFormat)) {
+            throw std::runtime_error("Failed to load DDS file, the format is not block compressed!");
+        }
+        if (read<uint32_t>(data, 132) != 3) {
+            throw std::runtime_error("Failed to load DDS file, only 2d textures are supported!");
+        }
+        m_faces = (read<uint32_t>(data, 136) & 0x4) ? 6 : 1;
+        m_layers = std::max(read<uint32_t>(data, 140), 1u);
+        dataOffset = 148;
+    } else if (!formatFromFourCC(code, m_internalFormat)) {
+        throw std::runtime_error("Failed to load DDS file, the format is not block compressed!");
+    }
+    checkDimensions(m_width, m_height, m_levels, m_layers, m_faces, "DDS");
+    // every layer (faces count as layers) stores its whole mip chain before the next one
+    size_t offset = dataOffset;
+    for (uint32_t layer = 0; layer < m_layers * m_faces; layer++) {
+        for (uint32_t level = 0; level < m_levels; level++) {
+            // stops a huge layer count in a small file before it builds millions of regions
+            if (levelSize(level) > size - offset) {
+                throw std::runtime_error("Failed to load DDS file, it is truncated!");
+            }
+            m_regions.push_back({level, layer, 1, offset, levelSize(level)});
+            offset += levelSize(level);
+        }
+    }
+}
+
+size_t TextureFile::levelSize(uint32_t level) const {
+    CompressedBlockInfo block = {};
+    if (!getCompressedBlockInfo(m_internalFormat, block)) {
+        throw std::runtime_error("Failed to load texture file, the format is not block compressed!");
+    }
+    size_t blocksX = (std::max(m_width >> level, 1u) + block.width - 1) / block.width;
+    size_t blocksY = (std::max(m_height >> level, 1u) + block.height - 1) / block.height;
+    return blocksX * blocksY * block.size;
+}
+
+} // namespace gl
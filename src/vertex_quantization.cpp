@@ -0,0 +1,385 @@
+#include "vertex_quantization.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace gl {
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7fffffff;
+    if (magnitude >= 0x7f800000) {
+        // infinity stays infinity, nans stay quiet nans
+        return uint16_t(sign | 0x7c00 | (magnitude > 0x7f800000 ? 0x200 : 0));
+    }
+    if (magnitude >= 0x477ff000) {
+        // 65520 and up round past the largest half
+        return uint16_t(sign | 0x7c00);
+    }
+    if (magnitude < 0x38800000) {
+        // below the smallest normal half, adding 0.5 lines the mantissa up with the denormal steps and lets the fpu round
+        float shifted;
+        std::memcpy(&shifted, &magnitude, sizeof(shifted));
+        shifted += 0.5f;
+        std::memcpy(&magnitude, &shifted, sizeof(magnitude));
+        return uint16_t(sign | (magnitude - 0x3f000000));
+    }
+    // rebias the exponent from 127 to 15 and round the 13 dropped bits to nearest even
+    magnitude += 0xc8000fff + ((magnitude >> 13) & 1);
+    return uint16_t(sign | (magnitude >> 13));
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = uint32_t(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1f;
+    uint32_t mantissa = value & 0x3ff;
+    if (exponent == 0) {
+        float magnitude = std::ldexp(float(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    uint32_t bits = sign | (exponent == 31 ? 0x7f800000 | (mantissa << 13) : ((exponent + 112) << 23) | (mantissa << 13));
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// the scalar loops round with nearbyint so they agree with the vector conversions, which round to nearest even
+template <typename T>
+static T quantize(float value, float low, float scale) {
+    return T(std::nearbyint(std::min(std::max(value, low), 1.0f) * scale));
+}
+
+#ifdef OPENGL_HPP_AVX2
+
+OPENGL_HPP_TARGET_AVX2 static size_t packHalfAVX2(const float *src, uint16_t *dst, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), half);
+    }
+    return i;
+}
+
+OPENGL_HPP_TARGET_AVX2 static __m256i quantizeAVX2(__m256 value, float low, float scale) {
+    value = _mm256_min_ps(_mm256_max_ps(value, _mm256_set1_ps(low)), _mm256_set1_ps(1.0f));
+    return _mm256_cvtps_epi32(_mm256_mul_ps(value, _mm256_set1_ps(scale)));
+}
+
+// signed and unsigned 16 bit results for the 8 floats at src, the packs interleave the two lanes so they get reordered
+OPENGL_HPP_TARGET_AVX2 static size_t pack16AVX2(const float *src, void *dst, size_t count, bool snorm) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i value = quantizeAVX2(_mm256_loadu_ps(src + i), snorm ? -1.0f : 0.0f, snorm ? 32767.0f : 65535.0f);
+        __m256i packed = snorm ? _mm256_packs_epi32(value, value) : _mm256_packus_epi32(value, value);
+        packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(static_cast<uint16_t *>(dst) + i), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+OPENGL_HPP_TARGET_AVX2 static size_t pack8AVX2(const float *src, void *dst, size_t count, bool snorm) {
+    const __m256i order = _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i value = quantizeAVX2(_mm256_loadu_ps(src + i), snorm ? -1.0f : 0.0f, snorm ? 127.0f : 255.0f);
+        // the values are already in range, so the saturating packs only narrow
+        __m256i packed = _mm256_packs_epi32(value, value);
+        packed = snorm ? _mm256_packs_epi16(packed, packed) : _mm256_packus_epi16(packed, packed);
+        packed = _mm256_permutevar8x32_epi32(packed, order);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(static_cast<uint8_t *>(dst) + i), _mm256_castsi256_si128(packed));
+    }
+    return i;
+}
+
+OPENGL_HPP_TARGET_AVX2 static size_t packNormalsAVX2(const float *src, uint32_t *dst, size_t count) {
+    const __m256i index = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256i mask = _mm256_set1_epi32(0x3ff);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float *base = src + i * 3;
+        __m256i x = quantizeAVX2(_mm256_i32gather_ps(base, index, 4), -1.0f, 511.0f);
+        __m256i y = quantizeAVX2(_mm256_i32gather_ps(base + 1, index, 4), -1.0f, 511.0f);
+        __m256i z = quantizeAVX2(_mm256_i32gather_ps(base + 2, index, 4), -1.0f, 511.0f);
+        __m256i packed = _mm256_or_si256(_mm256_and_si256(x, mask),
+                                         _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(y, mask), 10), _mm256_slli_epi32(_mm256_and_si256(z, mask), 20)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), packed);
+    }
+    return i;
+}
+
+// 8 vertices are 24 floats, so three vectors cover them and the xyz pattern of the scale repeats every block
+OPENGL_HPP_TARGET_AVX2 static size_t packPositionsAVX2(const float *src, uint16_t *dst, size_t count, const float *offset, const float *inverseScale) {
+    __m256 offsets[3];
+    __m256 scales[3];
+    for (int v = 0; v < 3; v++) {
+        float o[8];
+        float s[8];
+        for (int lane = 0; lane < 8; lane++) {
+            o[lane] = offset[(v * 8 + lane) % 3];
+            s[lane] = inverseScale[(v * 8 + lane) % 3];
+        }
+        offsets[v] = _mm256_loadu_ps(o);
+        scales[v] = _mm256_loadu_ps(s);
+    }
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        for (int v = 0; v < 3; v++) {
+            __m256 value = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(src + i * 3 + v * 8), offsets[v]), scales[v]);
+            __m256i quantized = quantizeAVX2(value, 0.0f, 65535.0f);
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(quantized, quantized), _MM_SHUFFLE(3, 1, 2, 0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 3 + v * 8), _mm256_castsi256_si128(packed));
+        }
+    }
+    return i;
+}
+
+#endif
+
+#ifdef OPENGL_HPP_NEON
+
+static size_t packHalfNEON(const float *src, uint16_t *dst, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    }
+    return i;
+}
+
+static int32x4_t quantizeNEON(float32x4_t value, float low, float scale) {
+    value = vminq_f32(vmaxq_f32(value, vdupq_n_f32(low)), vdupq_n_f32(1.0f));
+    return vcvtnq_s32_f32(vmulq_n_f32(value, scale));
+}
+
+static size_t pack16NEON(const float *src, void *dst, size_t count, bool snorm) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        int32x4_t value = quantizeNEON(vld1q_f32(src + i), snorm ? -1.0f : 0.0f, snorm ? 32767.0f : 65535.0f);
+        if (snorm) {
+            vst1_s16(static_cast<int16_t *>(dst) + i, vqmovn_s32(value));
+        } else {
+            vst1_u16(static_cast<uint16_t *>(dst) + i, vqmovun_s32(value));
+        }
+    }
+    return i;
+}
+
+static size_t pack8NEON(const float *src, void *dst, size_t count, bool snorm) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        float low = snorm ? -1.0f : 0.0f;
+        float scale = snorm ? 127.0f : 255.0f;
+        int16x8_t value = vcombine_s16(vqmovn_s32(quantizeNEON(vld1q_f32(src + i), low, scale)), vqmovn_s32(quantizeNEON(vld1q_f32(src + i + 4), low, scale)));
+        if (snorm) {
+            vst1_s8(static_cast<int8_t *>(dst) + i, vqmovn_s16(value));
+        } else {
+            vst1_u8(static_cast<uint8_t *>(dst) + i, vqmovun_s16(value));
+        }
+    }
+    return i;
+}
+
+static size_t packNormalsNEON(const float *src, uint32_t *dst, size_t count) {
+    const uint32x4_t mask = vdupq_n_u32(0x3ff);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x3_t xyz = vld3q_f32(src + i * 3);
+        uint32x4_t x = vandq_u32(vreinterpretq_u32_s32(quantizeNEON(xyz.val[0], -1.0f, 511.0f)), mask);
+        uint32x4_t y = vandq_u32(vreinterpretq_u32_s32(quantizeNEON(xyz.val[1], -1.0f, 511.0f)), mask);
+        uint32x4_t z = vandq_u32(vreinterpretq_u32_s32(quantizeNEON(xyz.val[2], -1.0f, 511.0f)), mask);
+        vst1q_u32(dst + i, vorrq_u32(x, vorrq_u32(vshlq_n_u32(y, 10), vshlq_n_u32(z, 20))));
+    }
+    return i;
+}
+
+static size_t packPositionsNEON(const float *src, uint16_t *dst, size_t count, const float *offset, const float *inverseScale) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // deinterleaved loads keep one component per register
+        float32x4x3_t xyz = vld3q_f32(src + i * 3);
+        uint16x4x3_t packed;
+        for (int c = 0; c < 3; c++) {
+            float32x4_t value = vmulq_n_f32(vsubq_f32(xyz.val[c], vdupq_n_f32(offset[c])), inverseScale[c]);
+            packed.val[c] = vqmovun_s32(quantizeNEON(value, 0.0f, 65535.0f));
+        }
+        vst3_u16(dst + i * 3, packed);
+    }
+    return i;
+}
+
+#endif
+
+void packHalf(const float *src, uint16_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = packHalfAVX2(src, dst, count);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = packHalfNEON(src, dst, count);
+#endif
+    for (; i < count; i++) {
+        dst[i] = floatToHalf(src[i]);
+    }
+}
+
+void packSnorm16(const float *src, int16_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = pack16AVX2(src, dst, count, true);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = pack16NEON(src, dst, count, true);
+#endif
+    for (; i < count; i++) {
+        dst[i] = quantize<int16_t>(src[i], -1.0f, 32767.0f);
+    }
+}
+
+void packUnorm16(const float *src, uint16_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = pack16AVX2(src, dst, count, false);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = pack16NEON(src, dst, count, false);
+#endif
+    for (; i < count; i++) {
+        dst[i] = quantize<uint16_t>(src[i], 0.0f, 65535.0f);
+    }
+}
+
+void packSnorm8(const float *src, int8_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = pack8AVX2(src, dst, count, true);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = pack8NEON(src, dst, count, true);
+#endif
+    for (; i < count; i++) {
+        dst[i] = quantize<int8_t>(src[i], -1.0f, 127.0f);
+    }
+}
+
+void packUnorm8(const float *src, uint8_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = pack8AVX2(src, dst, count, false);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = pack8NEON(src, dst, count, false);
+#endif
+    for (; i < count; i++) {
+        dst[i] = quantize<uint8_t>(src[i], 0.0f, 255.0f);
+    }
+}
+
+uint32_t packSnorm2101010(float x, float y, float z, float w) {
+    return (uint32_t(quantize<int32_t>(x, -1.0f, 511.0f)) & 0x3ff) |
+           (uint32_t(quantize<int32_t>(y, -1.0f, 511.0f)) & 0x3ff) << 10 |
+           (uint32_t(quantize<int32_t>(z, -1.0f, 511.0f)) & 0x3ff) << 20 |
+           (uint32_t(quantize<int32_t>(w, -1.0f, 1.0f)) & 0x3) << 30;
+}
+
+uint32_t packUnorm2101010(float x, float y, float z, float w) {
+    return quantize<uint32_t>(x, 0.0f, 1023.0f) |
+           quantize<uint32_t>(y, 0.0f, 1023.0f) << 10 |
+           quantize<uint32_t>(z, 0.0f, 1023.0f) << 20 |
+           quantize<uint32_t>(w, 0.0f, 3.0f) << 30;
+}
+
+void packNormals(const float *src, uint32_t *dst, size_t count) {
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = packNormalsAVX2(src, dst, count);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = packNormalsNEON(src, dst, count);
+#endif
+    for (; i < count; i++) {
+        dst[i] = packSnorm2101010(src[i * 3], src[i * 3 + 1], src[i * 3 + 2], 0.0f);
+    }
+}
+
+// the small float formats share the half exponent with fewer mantissa bits, they are rounded straight from the
+// float bits so a value is only rounded once
+static uint32_t packUnsignedFloat(float value, int mantissaBits) {
+    uint32_t infinity = 0x1fu << mantissaBits;
+    if (std::isnan(value)) {
+        return infinity | 1;
+    }
+    if (!(value > 0.0f)) {
+        return 0;
+    }
+    if (std::isinf(value)) {
+        return infinity;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t rounded;
+    if (bits < 0x38800000) {
+        // below the smallest normal value the steps are 2^-(14 + mantissaBits) apart, scaling by a power of two is exact
+        rounded = uint32_t(std::nearbyint(std::ldexp(value, 14 + mantissaBits)));
+    } else {
+        // rebias the exponent from 127 to 15 and round the dropped bits to nearest even, a carry moves into the exponent
+        int shift = 23 - mantissaBits;
+        bits -= 0x38000000;
+        rounded = (bits + (1u << (shift - 1)) - 1 + ((bits >> shift) & 1)) >> shift;
+    }
+    // finite values past the range clamp to the largest finite value
+    return std::min(rounded, infinity - 1);
+}
+
+uint32_t packR11G11B10F(float r, float g, float b) {
+    return packUnsignedFloat(r, 6) | packUnsignedFloat(g, 6) << 11 | packUnsignedFloat(b, 5) << 22;
+}
+
+PositionBounds packPositions(const float *src, uint16_t *dst, size_t count) {
+    float low[3] = {0.0f, 0.0f, 0.0f};
+    float high[3] = {0.0f, 0.0f, 0.0f};
+    if (count) {
+        std::copy(src, src + 3, low);
+        std::copy(src, src + 3, high);
+    }
+    for (size_t i = 1; i < count; i++) {
+        for (int c = 0; c < 3; c++) {
+            low[c] = std::min(low[c], src[i * 3 + c]);
+            high[c] = std::max(high[c], src[i * 3 + c]);
+        }
+    }
+    PositionBounds bounds;
+    float inverseScale[3];
+    for (int c = 0; c < 3; c++) {
+        float extent = high[c] - low[c];
+        bounds.offset[c] = low[c];
+        bounds.scale[c] = extent;
+        // a flat axis maps everything to 0
+        inverseScale[c] = extent > 0.0f ? 1.0f / extent : 0.0f;
+    }
+
+    size_t i = 0;
+#if defined(OPENGL_HPP_AVX2)
+    if (hasAVX2()) {
+        i = packPositionsAVX2(src, dst, count, bounds.offset, inverseScale);
+    }
+#elif defined(OPENGL_HPP_NEON)
+    i = packPositionsNEON(src, dst, count, bounds.offset, inverseScale);
+#endif
+    for (; i < count; i++) {
+        for (int c = 0; c < 3; c++) {
+            dst[i * 3 + c] = quantize<uint16_t>((src[i * 3 + c] - bounds.offset[c]) * inverseScale[c], 0.0f, 65535.0f);
+        }
+    }
+    return bounds;
+}
+
+} // namespace gl
@@ -0,0 +1,518 @@
+#include "virtual_texture.hpp"
+
+#include "file.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace gl {
+
+static constexpr uint32_t noFeedback = 0xffffffff;
+// feedback texels pack the page as mip << 24 | y << 12 | x
+static constexpr uint32_t maxPagesPerAxis = 1 << 12;
+// page table entries are rgba8ui, cache slot x, cache slot y, resident mip, valid
+static constexpr uint32_t maxCachePagesPerAxis = 256;
+
+static uint32_t mipLevelCount(uint32_t pagesX, uint32_t pagesY) {
+    uint32_t levels = 1;
+    while (pagesX % 2 == 0 && pagesY % 2 == 0) {
+        pagesX /= 2;
+        pagesY /= 2;
+        levels++;
+    }
+    return levels;
+}
+
+static uint32_t packEntry(uint32_t slotX, uint32_t slotY, uint32_t mip) {
+    return slotX | slotY << 8 | mip << 16 | 0xffu << 24;
+}
+
+VirtualTexture::VirtualTexture(const CreateInfo& createInfo, const Dispatch& d)
+  : m_dispatch(&d),
+    m_info(createInfo),
+    m_texture(Texture::createTexture(TextureType::e2D, d)),
+    m_pageTable(Texture::createTexture(TextureType::e2D, d)),
+    m_uniforms(Buffer::createBuffer(d)),
+    m_feedbackFramebuffer(Framebuffer::createFramebuffer(d)),
+    m_feedbackColor(Renderbuffer::createRenderbuffer(d)),
+    m_feedbackDepth(Renderbuffer::createRenderbuffer(d)),
+    m_maxLoading(std::max<size_t>(createInfo.loaderThreads, 1) * 4),
+    m_loaders(createInfo.loaderThreads, m_maxLoading) {
+    if (!m_info.loader || m_info.pageSize == 0 || m_info.width % m_info.pageSize || m_info.height % m_info.pageSize) {
+        throw std::runtime_error("Failed to create VirtualTexture, the size must be a multiple of the page size!");
+    }
+    uint32_t pagesX0 = m_info.width / m_info.pageSize;
+    uint32_t pagesY0 = m_info.height / m_info.pageSize;
+    if (pagesX0 > maxPagesPerAxis || pagesY0 > maxPagesPerAxis || m_info.cachePagesX > maxCachePagesPerAxis || m_info.cachePagesY > maxCachePagesPerAxis) {
+        throw std::runtime_error("Failed to create VirtualTexture, too many pages!");
+    }
+    m_mipLevels = mipLevelCount(pagesX0, pagesY0);
+
+    // sparse pages only line up with ours if the hardware page divides the page size
+    m_sparse = false;
+    if (m_info.preferSparse && m_info.border == 0 && isExtensionSupported("GL_ARB_sparse_texture", d)) {
+        GLint pageSizes = 0;
+        GLint pageX = 0;
+        GLint pageY = 0;
+        GLenum internalFormat = static_cast<GLenum>(m_info.internalFormat);
+        d.glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &pageSizes);
+        if (pageSizes > 0) {
+            d.glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_VIRTUAL_PAGE_SIZE_X_ARB, 1, &pageX);
+            d.glGetInternalformativ(GL_TEXTURE_2D, internalFormat, GL_VIRTUAL_PAGE_SIZE_Y_ARB, 1, &pageY);
+            m_sparse = pageX > 0 && pageY > 0 && m_info.pageSize % pageX == 0 && m_info.pageSize % pageY == 0;
+        }
+    }
+
+    if (m_sparse) {
+        m_texture.parameter(TextureParameter::eSparse, GL_TRUE, d);
+        m_texture.parameter(TextureParameter::eVirtualPageSizeIndex, 0, d);
+        m_texture.storage2D(m_mipLevels, m_info.internalFormat, m_info.width, m_info.height, d);
+        m_texture.parameter(TextureParameter::eMinFilter, static_cast<int>(Filter::eLinearMipmapLinear), d);
+    } else {
+        uint32_t stride = m_info.pageSize + 2 * m_info.border;
+        m_texture.storage2D(1, m_info.internalFormat, m_info.cachePagesX * stride, m_info.cachePagesY * stride, d);
+        m_texture.parameter(TextureParameter::eMinFilter, static_cast<int>(Filter::eLinear), d);
+    }
+    m_texture.parameter(TextureParameter::eMagFilter, static_cast<int>(Filter::eLinear), d);
+    m_texture.parameter(TextureParameter::eWrapS, static_cast<int>(Wrap::eClampToEdge), d);
+    m_texture.parameter(TextureParameter::eWrapT, static_cast<int>(Wrap::eClampToEdge), d);
+
+    // integer textures are only complete with nearest filtering
+    m_pageTable.storage2D(m_mipLevels, InternalFormat::eR8G8B8A8UInt, pagesX0, pagesY0, d);
+    m_pageTable.parameter(TextureParameter::eMinFilter, static_cast<int>(Filter::eNearestMipmapNearest), d);
+    m_pageTable.parameter(TextureParameter::eMagFilter, static_cast<int>(Filter::eNearest), d);
+    m_pageTableLevels.resize(m_mipLevels);
+    for (uint32_t mip = 0; mip < m_mipLevels; mip++) {
+        m_pageTableLevels[mip].resize(pagesX(mip) * pagesY(mip), 0);
+    }
+
+    // matches the VirtualTextureParams block in the glsl snippets
+    uint32_t stride = m_info.pageSize + 2 * m_info.border;
+    float params[8] = {
+        float(pagesX0), float(pagesY0), float(m_info.pageSize), float(m_info.border),
+        float(m_info.cachePagesX * stride), float(m_info.cachePagesY * stride),
+        -std::log2(float(std::max(m_info.feedbackDivisor, 1u))), float(m_mipLevels),
+    };
+    m_uniforms.storage(sizeof(params), params, BufferStorage::eNone, d);
+
+    uint32_t slotCount = m_info.cachePagesX * m_info.cachePagesY;
+    for (uint32_t slot = slotCount; slot > 0; slot--) {
+        m_freeSlots.push_back(slot - 1);
+    }
+
+    // the coarsest level is loaded up front and never evicted, so every lookup finds something
+    uint32_t coarsest = m_mipLevels - 1;
+    if (pagesX(coarsest) * pagesY(coarsest) > slotCount) {
+        throw std::runtime_error("Failed to create VirtualTexture, the cache cannot hold the coarsest level!");
+    }
+    for (uint32_t y = 0; y < pagesY(coarsest); y++) {
+        for (uint32_t x = 0; x < pagesX(coarsest); x++) {
+            LoadedPage loaded{{x, y, coarsest}, {}};
+            if (!m_info.loader(loaded.page, loaded.pixels) || loaded.pixels.size() < pageBytes()) {
+                throw std::runtime_error("Failed to load the coarsest VirtualTexture level!");
+            }
+            upload(loaded, true);
+        }
+    }
+    // the coarsest pages cover the whole table, so updating under them fills every entry
+    updatePageTable();
+}
+
+VirtualTexture::~VirtualTexture() {
+    m_loaders.drain();
+    destroyFeedbackTarget();
+    Framebuffer::deleteFramebuffer(m_feedbackFramebuffer, *m_dispatch);
+    Renderbuffer::deleteRenderbuffer(m_feedbackColor, *m_dispatch);
+    Renderbuffer::deleteRenderbuffer(m_feedbackDepth, *m_dispatch);
+    Buffer::deleteBuffer(m_uniforms, *m_dispatch);
+    Texture::deleteTexture(m_pageTable, *m_dispatch);
+    Texture::deleteTexture(m_texture, *m_dispatch);
+}
+
+void VirtualTexture::beginFeedback(uint32_t viewWidth, uint32_t viewHeight) {
+    const Dispatch& d = *m_dispatch;
+    uint32_t divisor = std::max(m_info.feedbackDivisor, 1u);
+    uint32_t width = std::max(viewWidth / divisor, 1u);
+    uint32_t height = std::max(viewHeight / divisor, 1u);
+    if (width != m_feedbackWidth || height != m_feedbackHeight) {
+        destroyFeedbackTarget();
+        createFeedbackTarget(width, height);
+    }
+    m_feedbackFramebuffer.bind(FramebufferTarget::eFramebuffer, d);
+    viewport(0, 0, m_feedbackWidth, m_feedbackHeight, d);
+    m_uniforms.bindBase(IndexedBufferTarget::eUniform, m_info.uniformBinding, d);
+    const uint32_t clearValue[4] = {noFeedback, noFeedback, noFeedback, noFeedback};
+    m_feedbackFramebuffer.clearColor(0, clearValue, d);
+    m_feedbackFramebuffer.clearDepth(1.0f, d);
+}
+
+void VirtualTexture::endFeedback() {
+    const Dispatch& d = *m_dispatch;
+    FeedbackSlot& slot = m_feedbackSlots[m_nextFeedbackSlot];
+    // every slot still in flight means the gpu is far behind, skip this frame's feedback rather than wait
+    if (slot.fence) {
+        return;
+    }
+    m_nextFeedbackSlot = (m_nextFeedbackSlot + 1) % m_feedbackSlots.size();
+    m_feedbackFramebuffer.bind(FramebufferTarget::eRead, d);
+    m_feedbackFramebuffer.readBuffer(FramebufferAttachment::eColor0, d);
+    slot.buffer.bind(BufferTarget::ePixelPack, d);
+    readPixels(0, 0, m_feedbackWidth, m_feedbackHeight, Format::eRInteger, Type::eUnsignedInt, nullptr, d);
+    Buffer::unbind(BufferTarget::ePixelPack, d);
+    slot.fence = d.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    d.glFlush();
+}
+
+void VirtualTexture::update() {
+    const Dispatch& d = *m_dispatch;
+
+    // oldest readback first, stop at the first one still in flight
+    std::unordered_set<uint32_t> visible;
+    for (size_t i = 0; i < m_feedbackSlots.size(); i++) {
+        FeedbackSlot& slot = m_feedbackSlots[(m_nextFeedbackSlot + i) % m_feedbackSlots.size()];
+        if (!slot.fence) {
+            continue;
+        }
+        GLenum status = d.glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            break;
+        }
+        d.glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        size_t texels = size_t(m_feedbackWidth) * m_feedbackHeight;
+        for (size_t texel = 0; texel < texels; texel++) {
+            if (slot.mapped[texel] != noFeedback) {
+                visible.insert(slot.mapped[texel]);
+            }
+        }
+    }
+
+    if (!visible.empty()) {
+        m_frame++;
+        std::vector<PageId> pages;
+        pages.reserve(visible.size());
+        for (uint32_t value : visible) {
+            PageId page{value & 0xfff, (value >> 12) & 0xfff, value >> 24};
+            if (page.mip < m_mipLevels && page.x < pagesX(page.mip) && page.y < pagesY(page.mip)) {
+                pages.push_back(page);
+            }
+        }
+        // coarse pages first, they cover the most screen while the finer ones arrive
+        std::sort(pages.begin(), pages.end(), [](const PageId& a, const PageId& b) { return a.mip > b.mip; });
+        for (auto& page : pages) {
+            request(page);
+        }
+    }
+
+    std::vector<LoadedPage> loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_loadedMutex);
+        loaded.swap(m_loaded);
+    }
+    std::sort(loaded.begin(), loaded.end(), [](const LoadedPage& a, const LoadedPage& b) { return a.page.mip > b.page.mip; });
+    uint32_t uploads = 0;
+    size_t i = 0;
+    for (; i < loaded.size() && uploads < m_info.uploadsPerFrame; i++) {
+        m_loading.erase(pageKey(loaded[i].page));
+        // failed loads and pages the cache has no room for are asked for again by later feedback
+        if (!loaded[i].pixels.empty() && upload(loaded[i], false)) {
+            uploads++;
+        }
+    }
+    if (i < loaded.size()) {
+        std::lock_guard<std::mutex> lock(m_loadedMutex);
+        m_loaded.insert(m_loaded.end(), std::make_move_iterator(loaded.begin() + i), std::make_move_iterator(loaded.end()));
+    }
+
+    updatePageTable();
+}
+
+void VirtualTexture::bind(uint32_t textureUnit, uint32_t pageTableUnit) {
+    m_texture.bindUnit(textureUnit, *m_dispatch);
+    m_pageTable.bindUnit(pageTableUnit, *m_dispatch);
+    m_uniforms.bindBase(IndexedBufferTarget::eUniform, m_info.uniformBinding, *m_dispatch);
+}
+
+bool VirtualTexture::isSparse() const {
+    return m_sparse;
+}
+
+uint32_t VirtualTexture::getMipLevels() const {
+    return m_mipLevels;
+}
+
+size_t VirtualTexture::getResidentPageCount() const {
+    return m_resident.size();
+}
+
+const char *VirtualTexture::getFeedbackGLSL() {
+    return R"(
+layout(std140, binding = VT_BINDING) uniform VirtualTextureParams {
+    vec4 vtPages;  // pages x and y at mip 0, page size, border
+    vec4 vtCache;  // cache texture size, feedback lod bias, mip levels
+};
+
+uint vtFeedback(vec2 uv) {
+    uv = clamp(uv, 0.0, 0.99999);
+    vec2 texel = uv * vtPages.xy * vtPages.z;
+    vec2 dx = dFdx(texel);
+    vec2 dy = dFdy(texel);
+    // the feedback target is smaller than the view, the bias brings the lod back to the view's
+    float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8)) + vtCache.z;
+    uint level = uint(clamp(int(lod), 0, int(vtCache.w) - 1));
+    uvec2 page = uvec2(uv * vtPages.xy) >> level;
+    return (level << 24) | (page.y << 12) | page.x;
+}
+)";
+}
+
+const char *VirtualTexture::getSampleGLSL() {
+    return R"(
+layout(std140, binding = VT_BINDING) uniform VirtualTextureParams {
+    vec4 vtPages;  // pages x and y at mip 0, page size, border
+    vec4 vtCache;  // cache texture size, feedback lod bias, mip levels
+};
+layout(binding = VT_TEXTURE_UNIT) uniform sampler2D vtTexture;
+layout(binding = VT_PAGE_TABLE_UNIT) uniform usampler2D vtPageTable;
+
+vec4 vtSample(vec2 uv) {
+    uv = clamp(uv, 0.0, 0.99999);
+    vec2 texel = uv * vtPages.xy * vtPages.z;
+    vec2 dx = dFdx(texel);
+    vec2 dy = dFdy(texel);
+    float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8));
+    int level = clamp(int(lod), 0, int(vtCache.w) - 1);
+    // z is the finest mip resident for this region, coarser than level while pages stream in
+    uvec4 entry = texelFetch(vtPageTable, ivec2(uv * vtPages.xy) >> level, level);
+#ifdef VT_SPARSE
+    return textureLod(vtTexture, uv, max(lod, float(entry.z)));
+#else
+    vec2 pageUV = fract(uv * vtPages.xy / float(1u << entry.z));
+    float stride = vtPages.z + 2.0 * vtPages.w;
+    vec2 cacheTexel = vec2(entry.xy) * stride + vtPages.w + pageUV * vtPages.z;
+    return textureLod(vtTexture, cacheTexel / vtCache.xy, 0.0);
+#endif
+}
+)";
+}
+
+VirtualTexture::PageLoader VirtualTexture::createFileLoader(const std::string& filePath, const CreateInfo& createInfo) {
+    std::shared_ptr<MappedFile> file(new MappedFile(MappedFile::mapFile(filePath.c_str())), [](MappedFile *mappedFile) {
+        MappedFile::unmapFile(*mappedFile);
+        delete mappedFile;
+    });
+    uint32_t stride = createInfo.pageSize + 2 * createInfo.border;
+    size_t pageBytes = size_t(stride) * stride * createInfo.texelSize;
+    uint32_t pagesX0 = createInfo.width / createInfo.pageSize;
+    uint32_t pagesY0 = createInfo.height / createInfo.pageSize;
+    // index of the first page of each level
+    std::vector<size_t> levelStart;
+    size_t pageCount = 0;
+    for (uint32_t mip = 0; mip < mipLevelCount(pagesX0, pagesY0); mip++) {
+        levelStart.push_back(pageCount);
+        pageCount += size_t(pagesX0 >> mip) * (pagesY0 >> mip);
+    }
+    return [file, pageBytes, pagesX0, levelStart](const PageId& page, std::vector<uint8_t>& pixels) {
+        if (page.mip >= levelStart.size()) {
+            return false;
+        }
+        size_t offset = (levelStart[page.mip] + size_t(page.y) * (pagesX0 >> page.mip) + page.x) * pageBytes;
+        if (offset + pageBytes > file->size()) {
+            return false;
+        }
+        const uint8_t *data = static_cast<const uint8_t *>(file->data()) + offset;
+        pixels.assign(data, data + pageBytes);
+        return true;
+    };
+}
+
+uint64_t VirtualTexture::pageKey(const PageId& page) const {
+    return uint64_t(page.mip) << 48 | uint64_t(page.y) << 24 | page.x;
+}
+
+uint32_t VirtualTexture::pagesX(uint32_t mip) const {
+    return (m_info.width / m_info.pageSize) >> mip;
+}
+
+uint32_t VirtualTexture::pagesY(uint32_t mip) const {
+    return (m_info.height / m_info.pageSize) >> mip;
+}
+
+size_t VirtualTexture::pageBytes() const {
+    uint32_t stride = m_info.pageSize + 2 * m_info.border;
+    return size_t(stride) * stride * m_info.texelSize;
+}
+
+void VirtualTexture::createFeedbackTarget(uint32_t width, uint32_t height) {
+    const Dispatch& d = *m_dispatch;
+    m_feedbackWidth = width;
+    m_feedbackHeight = height;
+    m_feedbackColor.storage(InternalFormat::eR32UInt, width, height, d);
+    m_feedbackDepth.storage(InternalFormat::eD24, width, height, d);
+    m_feedbackFramebuffer.renderbuffer(FramebufferAttachment::eColor0, m_feedbackColor, d);
+    m_feedbackFramebuffer.renderbuffer(FramebufferAttachment::eDepth, m_feedbackDepth, d);
+    if (m_feedbackFramebuffer.checkStatus(FramebufferTarget::eFramebuffer, d) != FramebufferStatus::eComplete) {
+        throw std::runtime_error("VirtualTexture feedback framebuffer is incomplete!");
+    }
+
+    // three readbacks in flight cover the usual cpu/gpu latency without waiting
+    size_t size = size_t(width) * height * sizeof(uint32_t);
+    for (int i = 0; i < 3; i++) {
+        Buffer buffer = Buffer::createBuffer(d);
+        buffer.storage(size, nullptr, BufferStorage::eRead | BufferStorage::ePersistent | BufferStorage::eCoherent, d);
+        auto *mapped = static_cast<const uint32_t *>(buffer.mapRange(0, size, BufferMap::eRead | BufferMap::ePersistent | BufferMap::eCoherent, d));
+        m_feedbackSlots.push_back({buffer, mapped, nullptr});
+    }
+    m_nextFeedbackSlot = 0;
+}
+
+void VirtualTexture::destroyFeedbackTarget() {
+    for (auto& slot : m_feedbackSlots) {
+        if (slot.fence) {
+            m_dispatch->glDeleteSync(slot.fence);
+        }
+        slot.buffer.unmap(*m_dispatch);
+        Buffer::deleteBuffer(slot.buffer, *m_dispatch);
+    }
+    m_feedbackSlots.clear();
+}
+
+void VirtualTexture::request(PageId page) {
+    for (; page.mip < m_mipLevels; page.mip++, page.x /= 2, page.y /= 2) {
+        auto itr = m_resident.find(pageKey(page));
+        if (itr != m_resident.end()) {
+            // ancestors are always at least as recent as their children, so eviction takes fine pages first
+            itr->second.lastUsed = m_frame;
+        } else {
+            schedule(page);
+        }
+    }
+}
+
+void VirtualTexture::schedule(const PageId& page) {
+    uint64_t key = pageKey(page);
+    // keep the loader queue short so submit never blocks, anything skipped is asked for again next feedback
+    if (m_loading.count(key) || m_loading.size() >= m_maxLoading) {
+        return;
+    }
+    m_loading.insert(key);
+    m_loaders.submit([this, page]() {
+        LoadedPage loaded{page, {}};
+        try {
+            // a short page counts as a failed load, it is dropped and asked for again
+            if (!m_info.loader(page, loaded.pixels) || loaded.pixels.size() < pageBytes()) {
+                loaded.pixels.clear();
+            }
+        } catch (const std::exception&) {
+            loaded.pixels.clear();
+        }
+        std::lock_guard<std::mutex> lock(m_loadedMutex);
+        m_loaded.push_back(std::move(loaded));
+    });
+}
+
+bool VirtualTexture::upload(LoadedPage& loaded, bool pinned) {
+    const Dispatch& d = *m_dispatch;
+    uint64_t key = pageKey(loaded.page);
+    if (m_resident.count(key)) {
+        return true;
+    }
+    uint32_t stride = m_info.pageSize + 2 * m_info.border;
+    if (m_freeSlots.empty()) {
+        // least recently seen page that is not visible in the latest feedback
+        auto victim = m_resident.end();
+        for (auto itr = m_resident.begin(); itr != m_resident.end(); ++itr) {
+            if (itr->second.pinned || itr->second.lastUsed >= m_frame) {
+                continue;
+            }
+            if (victim == m_resident.end() || itr->second.lastUsed < victim->second.lastUsed ||
+                (itr->second.lastUsed == victim->second.lastUsed && (itr->first >> 48) < (victim->first >> 48))) {
+                victim = itr;
+            }
+        }
+        if (victim == m_resident.end()) {
+            return false;
+        }
+        evict(victim->first);
+    }
+    uint32_t slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+
+    const PageId& page = loaded.page;
+    if (m_sparse) {
+        int32_t x = page.x * m_info.pageSize;
+        int32_t y = page.y * m_info.pageSize;
+        m_texture.pageCommitment(TextureType::e2D, page.mip, x, y, 0, m_info.pageSize, m_info.pageSize, 1, true, d);
+        m_texture.subImage2D(page.mip, x, y, m_info.pageSize, m_info.pageSize, m_info.format, m_info.type, loaded.pixels.data(), d);
+    } else {
+        int32_t x = (slot % m_info.cachePagesX) * stride;
+        int32_t y = (slot / m_info.cachePagesX) * stride;
+        m_texture.subImage2D(0, x, y, stride, stride, m_info.format, m_info.type, loaded.pixels.data(), d);
+    }
+    m_resident[key] = {slot, m_frame, pinned};
+    m_dirtyPages.push_back(page);
+    return true;
+}
+
+void VirtualTexture::evict(uint64_t key) {
+    auto itr = m_resident.find(key);
+    if (m_sparse) {
+        PageId page{uint32_t(key & 0xffffff), uint32_t((key >> 24) & 0xffffff), uint32_t(key >> 48)};
+        m_texture.pageCommitment(TextureType::e2D, page.mip, page.x * m_info.pageSize, page.y * m_info.pageSize, 0, m_info.pageSize, m_info.pageSize, 1, false, *m_dispatch);
+    }
+    m_freeSlots.push_back(itr->second.slot);
+    m_resident.erase(itr);
+    m_dirtyPages.push_back({uint32_t(key & 0xffffff), uint32_t((key >> 24) & 0xffffff), uint32_t(key >> 48)});
+}
+
+void VirtualTexture::updatePageTable() {
+    if (m_dirtyPages.empty()) {
+        return;
+    }
+    const Dispatch& d = *m_dispatch;
+    // coarsest first, a page whose ancestor is also dirty is covered by the ancestor's rect
+    std::sort(m_dirtyPages.begin(), m_dirtyPages.end(), [](const PageId& a, const PageId& b) { return a.mip > b.mip; });
+    std::unordered_set<uint64_t> updated;
+    std::vector<uint32_t> rect;
+    for (const PageId& dirty : m_dirtyPages) {
+        bool covered = false;
+        for (PageId page = dirty; page.mip < m_mipLevels && !covered; page.mip++, page.x /= 2, page.y /= 2) {
+            covered = updated.count(pageKey(page)) != 0;
+        }
+        if (covered) {
+            continue;
+        }
+        updated.insert(pageKey(dirty));
+        // the page covers a 2^n square of entries n levels finer, walked coarse to fine so a page that is not
+        // resident inherits the entry of its parent, which is either already rewritten or outside the rect
+        for (uint32_t mip = dirty.mip + 1; mip-- > 0;) {
+            uint32_t shift = dirty.mip - mip;
+            uint32_t x0 = dirty.x << shift;
+            uint32_t y0 = dirty.y << shift;
+            uint32_t extent = 1u << shift;
+            std::vector<uint32_t>& level = m_pageTableLevels[mip];
+            rect.resize(size_t(extent) * extent);
+            for (uint32_t y = y0; y < y0 + extent; y++) {
+                for (uint32_t x = x0; x < x0 + extent; x++) {
+                    auto itr = m_resident.find(pageKey({x, y, mip}));
+                    uint32_t& entry = level[y * pagesX(mip) + x];
+                    if (itr != m_resident.end()) {
+                        entry = packEntry(itr->second.slot % m_info.cachePagesX, itr->second.slot / m_info.cachePagesX, mip);
+                    } else if (mip + 1 < m_mipLevels) {
+                        entry = m_pageTableLevels[mip + 1][(y / 2) * pagesX(mip + 1) + x / 2];
+                    } else {
+                        entry = 0;
+                    }
+                    rect[(y - y0) * extent + (x - x0)] = entry;
+                }
+            }
+            m_pageTable.subImage2D(mip, x0, y0, extent, extent, Format::eRGBAInteger, Type::eUnsignedByte, rect.data(), d);
+        }
+    }
+    m_dirtyPages.clear();
+}
+
+} // namespace gl
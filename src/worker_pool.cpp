@@ -0,0 +1,87 @@
+#include "worker_pool.hpp"
+
+namespace gl {
+
+WorkerPool::WorkerPool(size_t threadCount, size_t queueCapacity) : m_capacity(queueCapacity ? queueCapacity : 1) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        m_threads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_taskAvailable.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> task) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_spaceAvailable.wait(lock, [this] { return m_tasks.size() < m_capacity; });
+    m_tasks.push_back(std::move(task));
+    lock.unlock();
+    m_taskAvailable.notify_one();
+}
+
+void WorkerPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_tasks.empty() && m_active == 0; });
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkerPool::drain() noexcept {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_tasks.empty() && m_active == 0; });
+    m_error = nullptr;
+}
+
+size_t WorkerPool::getThreadCount() const {
+    return m_threads.size();
+}
+
+void WorkerPool::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // pending tasks still run after the pool starts shutting down
+            m_taskAvailable.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            m_active++;
+        }
+        m_spaceAvailable.notify_one();
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (error && !m_error) {
+                m_error = error;
+            }
+            m_active--;
+            if (m_tasks.empty() && m_active == 0) {
+                m_idle.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace gl
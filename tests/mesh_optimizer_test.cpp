@@ -0,0 +1,151 @@
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// cpu only, needs no context
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (false)
+
+struct Mesh {
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    size_t vertexCount;
+};
+
+// a size x size quad grid with its triangles in random order, the worst case for a vertex cache
+static Mesh shuffledGrid(uint32_t size) {
+    Mesh mesh;
+    uint32_t row = size + 1;
+    mesh.vertexCount = size_t(row) * row;
+    for (uint32_t y = 0; y < row; y++) {
+        for (uint32_t x = 0; x < row; x++) {
+            mesh.positions.insert(mesh.positions.end(), {float(x), float(y), 0.0f});
+        }
+    }
+    std::vector<std::vector<uint32_t>> triangles;
+    for (uint32_t y = 0; y < size; y++) {
+        for (uint32_t x = 0; x < size; x++) {
+            uint32_t v = y * row + x;
+            triangles.push_back({v, v + 1, v + row});
+            triangles.push_back({v + 1, v + row + 1, v + row});
+        }
+    }
+    std::mt19937 rng(7);
+    std::shuffle(triangles.begin(), triangles.end(), rng);
+    for (auto& triangle : triangles) {
+        mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+    }
+    return mesh;
+}
+
+// triangles rotated to start at their smallest index, which keeps the winding, then sorted
+static std::vector<uint32_t> canonicalTriangles(const std::vector<uint32_t>& indices) {
+    std::vector<std::vector<uint32_t>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        std::vector<uint32_t> triangle(indices.begin() + i, indices.begin() + i + 3);
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    std::vector<uint32_t> flat;
+    for (auto& triangle : triangles) {
+        flat.insert(flat.end(), triangle.begin(), triangle.end());
+    }
+    return flat;
+}
+
+static void testTrianglesPreserved() {
+    Mesh mesh = shuffledGrid(32);
+    std::vector<uint32_t> expected = canonicalTriangles(mesh.indices);
+    std::vector<uint32_t> forsyth(mesh.indices.size());
+    gl::optimizeVertexCache(forsyth.data(), mesh.indices.data(), mesh.indices.size(), mesh.vertexCount);
+    CHECK(canonicalTriangles(forsyth) == expected);
+
+    std::vector<uint32_t> tipsify(mesh.indices.size());
+    gl::optimizeVertexCacheTipsify(tipsify.data(), mesh.indices.data(), mesh.indices.size(), mesh.vertexCount);
+    CHECK(canonicalTriangles(tipsify) == expected);
+
+    std::vector<uint32_t> overdraw(mesh.indices.size());
+    gl::optimizeOverdraw(overdraw.data(), forsyth.data(), forsyth.size(), mesh.positions.data(), mesh.vertexCount, sizeof(float) * 3);
+    CHECK(canonicalTriangles(overdraw) == expected);
+}
+
+static void testACMRDrops() {
+    Mesh mesh = shuffledGrid(64);
+    gl::VertexCacheStats before = gl::analyzeVertexCache(mesh.indices.data(), mesh.indices.size(), mesh.vertexCount);
+    CHECK(before.triangleCount == mesh.indices.size() / 3);
+    CHECK(before.uniqueVertices == mesh.vertexCount);
+
+    std::vector<uint32_t> forsyth(mesh.indices.size());
+    gl::optimizeVertexCache(forsyth.data(), mesh.indices.data(), mesh.indices.size(), mesh.vertexCount);
+    gl::VertexCacheStats after = gl::analyzeVertexCache(forsyth.data(), forsyth.size(), mesh.vertexCount);
+    CHECK(after.acmr < before.acmr);
+    // a shuffled grid transforms close to every corner, an optimised one well under one vertex per triangle
+    CHECK(before.acmr > 1.5f);
+    CHECK(after.acmr < 1.0f);
+    CHECK(after.atvr < before.atvr);
+
+    std::vector<uint32_t> tipsify(mesh.indices.size());
+    gl::optimizeVertexCacheTipsify(tipsify.data(), mesh.indices.data(), mesh.indices.size(), mesh.vertexCount);
+    CHECK(gl::analyzeVertexCache(tipsify.data(), tipsify.size(), mesh.vertexCount).acmr < 1.0f);
+}
+
+static void testRemapRoundTrip() {
+    Mesh mesh = shuffledGrid(16);
+    // one vertex no triangle uses
+    mesh.positions.insert(mesh.positions.end(), {-1.0f, -1.0f, -1.0f});
+    mesh.vertexCount++;
+    std::vector<uint32_t> indices = mesh.indices;
+    std::vector<uint32_t> remap(mesh.vertexCount);
+    size_t used = gl::optimizeVertexFetchRemap(remap.data(), indices.data(), indices.size(), mesh.vertexCount);
+    CHECK(used == mesh.vertexCount - 1);
+    CHECK(remap.back() == UINT32_MAX);
+
+    std::vector<float> positions(used * 3);
+    gl::remapVertices(positions.data(), mesh.positions.data(), mesh.vertexCount, sizeof(float) * 3, remap.data());
+    bool same = true;
+    for (size_t i = 0; i < indices.size(); i++) {
+        same = same && indices[i] < used && std::memcmp(&positions[indices[i] * 3], &mesh.positions[mesh.indices[i] * 3], sizeof(float) * 3) == 0;
+    }
+    CHECK(same);
+    // first use order, so the indices never jump more than one past the highest seen
+    uint32_t next = 0;
+    bool ordered = true;
+    for (uint32_t index : indices) {
+        ordered = ordered && index <= next;
+        next = std::max(next, index + 1);
+    }
+    CHECK(ordered);
+
+    // the in place variant matches the two step one
+    std::vector<uint32_t> inPlaceIndices = mesh.indices;
+    std::vector<float> inPlacePositions = mesh.positions;
+    size_t inPlaceCount = gl::optimizeVertexFetch(inPlaceIndices.data(), inPlaceIndices.size(), inPlacePositions.data(), mesh.vertexCount, sizeof(float) * 3);
+    CHECK(inPlaceCount == used);
+    CHECK(inPlaceIndices == indices);
+    CHECK(std::equal(positions.begin(), positions.end(), inPlacePositions.begin()));
+}
+
+int main() {
+    testTrianglesPreserved();
+    testACMRDrops();
+    testRemapRoundTrip();
+    if (failures) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}
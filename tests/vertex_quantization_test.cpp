@@ -0,0 +1,179 @@
+#include "vertex_quantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// cpu only, needs no context
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failures++; \
+        } \
+    } while (false)
+
+// more than one vector block plus a tail, so the array helpers run both their simd and scalar loops
+static const size_t count = 1001;
+
+// floats spread over many exponents with both signs, plus a few past [-1, 1] so the clamps are hit
+static std::vector<float> randomFloats(size_t size, uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> mantissa(-1.5f, 1.5f);
+    std::uniform_int_distribution<int> exponent(-12, 2);
+    std::vector<float> values(size);
+    for (float& value : values) {
+        value = std::ldexp(mantissa(random), exponent(random));
+    }
+    return values;
+}
+
+// value of an unsigned small float code, 5 exponent bits over mantissaBits
+static double decodeUnsignedFloat(uint32_t code, int mantissaBits) {
+    uint32_t exponent = code >> mantissaBits;
+    uint32_t mantissa = code & ((1u << mantissaBits) - 1);
+    if (exponent == 0) {
+        return std::ldexp(double(mantissa), -14 - mantissaBits);
+    }
+    return std::ldexp(1.0 + std::ldexp(double(mantissa), -mantissaBits), int(exponent) - 15);
+}
+
+// tries every finite code and keeps the nearest, ties go to the even code
+static uint32_t bruteForceUnsignedFloat(float value, int mantissaBits) {
+    uint32_t best = 0;
+    double bestDistance = HUGE_VAL;
+    for (uint32_t code = 0; code < (31u << mantissaBits); code++) {
+        double distance = std::fabs(decodeUnsignedFloat(code, mantissaBits) - double(value));
+        if (distance < bestDistance || (distance == bestDistance && !(code & 1))) {
+            best = code;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+static void testHalfRoundTrip() {
+    // every half but the nans survives a trip through float
+    bool roundTrips = true;
+    for (uint32_t half = 0; half < 0x10000; half++) {
+        float value = gl::halfToFloat(uint16_t(half));
+        if ((half & 0x7c00) == 0x7c00 && (half & 0x3ff)) {
+            roundTrips = roundTrips && std::isnan(value) && std::isnan(gl::halfToFloat(gl::floatToHalf(value)));
+        } else {
+            roundTrips = roundTrips && gl::floatToHalf(value) == half;
+        }
+    }
+    CHECK(roundTrips);
+
+    CHECK(gl::floatToHalf(1.0f) == 0x3c00);
+    CHECK(gl::floatToHalf(-2.0f) == 0xc000);
+    CHECK(gl::floatToHalf(65504.0f) == 0x7bff);
+    CHECK(gl::floatToHalf(65519.0f) == 0x7bff);
+    CHECK(gl::floatToHalf(65520.0f) == 0x7c00);
+    CHECK(gl::floatToHalf(-INFINITY) == 0xfc00);
+    // halfway between two halves rounds to the even one
+    CHECK(gl::floatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3c00);
+    CHECK(gl::floatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3c02);
+    CHECK(gl::floatToHalf(std::ldexp(1.0f, -25)) == 0x0000);
+    CHECK(gl::floatToHalf(3.0f * std::ldexp(1.0f, -25)) == 0x0002);
+}
+
+// the array helpers have to match their scalar counterparts whichever path packs an element
+static void testSIMDMatchesScalar() {
+    std::vector<float> values = randomFloats(count * 3, 1);
+
+    std::vector<uint16_t> halves(count);
+    gl::packHalf(values.data(), halves.data(), count);
+    bool halfMatches = true;
+    for (size_t i = 0; i < count; i++) {
+        halfMatches = halfMatches && halves[i] == gl::floatToHalf(values[i]);
+    }
+    CHECK(halfMatches);
+
+    // a single element is always packed by the scalar loop
+    std::vector<int16_t> snorm16(count);
+    std::vector<uint16_t> unorm16(count);
+    std::vector<int8_t> snorm8(count);
+    std::vector<uint8_t> unorm8(count);
+    gl::packSnorm16(values.data(), snorm16.data(), count);
+    gl::packUnorm16(values.data(), unorm16.data(), count);
+    gl::packSnorm8(values.data(), snorm8.data(), count);
+    gl::packUnorm8(values.data(), unorm8.data(), count);
+    bool normMatches = true;
+    for (size_t i = 0; i < count; i++) {
+        int16_t s16;
+        uint16_t u16;
+        int8_t s8;
+        uint8_t u8;
+        gl::packSnorm16(&values[i], &s16, 1);
+        gl::packUnorm16(&values[i], &u16, 1);
+        gl::packSnorm8(&values[i], &s8, 1);
+        gl::packUnorm8(&values[i], &u8, 1);
+        normMatches = normMatches && snorm16[i] == s16 && unorm16[i] == u16 && snorm8[i] == s8 && unorm8[i] == u8;
+    }
+    CHECK(normMatches);
+
+    std::vector<uint32_t> normals(count);
+    gl::packNormals(values.data(), normals.data(), count);
+    bool normalMatches = true;
+    for (size_t i = 0; i < count; i++) {
+        normalMatches = normalMatches && normals[i] == gl::packSnorm2101010(values[i * 3], values[i * 3 + 1], values[i * 3 + 2], 0.0f);
+    }
+    CHECK(normalMatches);
+
+    std::vector<uint16_t> positions(count * 3);
+    gl::PositionBounds bounds = gl::packPositions(values.data(), positions.data(), count);
+    bool positionMatches = true;
+    for (size_t i = 0; i < count; i++) {
+        for (int c = 0; c < 3; c++) {
+            float value = (values[i * 3 + c] - bounds.offset[c]) * (1.0f / bounds.scale[c]);
+            uint16_t expected = uint16_t(std::nearbyint(std::fmin(std::fmax(value, 0.0f), 1.0f) * 65535.0f));
+            positionMatches = positionMatches && positions[i * 3 + c] == expected;
+        }
+    }
+    CHECK(positionMatches);
+    CHECK(*std::min_element(positions.begin(), positions.end()) == 0);
+    CHECK(*std::max_element(positions.begin(), positions.end()) == 65535);
+}
+
+static void testR11G11B10F() {
+    std::mt19937 random(2);
+    std::uniform_real_distribution<float> mantissa(0.0f, 1.0f);
+    // from the denormals up to past the largest finite value
+    std::uniform_int_distribution<int> exponent(-24, 17);
+    bool matches = true;
+    for (int i = 0; i < 2000; i++) {
+        float value = std::ldexp(mantissa(random), exponent(random));
+        uint32_t packed = gl::packR11G11B10F(value, value, value);
+        uint32_t r = packed & 0x7ff;
+        uint32_t g = (packed >> 11) & 0x7ff;
+        uint32_t b = packed >> 22;
+        matches = matches && r == bruteForceUnsignedFloat(value, 6) && g == r && b == bruteForceUnsignedFloat(value, 5);
+    }
+    CHECK(matches);
+
+    // the value that double rounding through a half used to get wrong
+    CHECK((gl::packR11G11B10F(65.4877f, 0.0f, 0.0f) & 0x7ff) == 0x541);
+    CHECK(gl::packR11G11B10F(1.0f, 1.0f, 1.0f) == (0x3c0u | 0x3c0u << 11 | 0x1e0u << 22));
+    CHECK(gl::packR11G11B10F(-1.0f, 0.0f, 0.0f) == 0);
+    CHECK((gl::packR11G11B10F(INFINITY, 0.0f, 0.0f) & 0x7ff) == 0x7c0);
+    CHECK((gl::packR11G11B10F(NAN, 0.0f, 0.0f) & 0x7ff) > 0x7c0);
+    CHECK((gl::packR11G11B10F(1.0e9f, 0.0f, 0.0f) & 0x7ff) == 0x7bf);
+}
+
+int main() {
+    testHalfRoundTrip();
+    testSIMDMatchesScalar();
+    testR11G11B10F();
+    if (failures) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}